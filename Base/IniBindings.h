@@ -0,0 +1,354 @@
+/* Copyright (c) 2026 Dreamy Cecil
+This program is free software; you can redistribute it and/or modify
+it under the terms of version 2 of the GNU General Public License as published by
+the Free Software Foundation
+
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License along
+with this program; if not, write to the Free Software Foundation, Inc.,
+51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA. */
+
+#ifndef XGIZMO_INCL_INIBINDINGS_H
+#define XGIZMO_INCL_INIBINDINGS_H
+
+#ifdef PRAGMA_ONCE
+  #pragma once
+#endif
+
+#include "IniReader.h"
+
+#include "../Base/STLIncludesBegin.h"
+#include <vector>
+#include "../Base/STLIncludesEnd.h"
+
+// Table of config keys bound to variables that are all set at once
+// Keys are looked up in the table while going through the config once, instead of looking up each variable in the config.
+// It can also be used as a handler for the streaming reader to set variables without creating a config at all.
+// NOTE: Variables are referenced directly, so they must exist for as long as they are bound!
+class CIniBindings : public CIniHandler {
+  public:
+    // Types of bound variables
+    enum EType {
+      E_BOOL,   // bool
+      E_INT,    // SLONG/INDEX
+      E_FLOAT,  // FLOAT
+      E_DOUBLE, // DOUBLE
+      E_STRING, // CTString
+    };
+
+  private:
+    // Variable bound to some key
+    struct Binding {
+      IniStr strSection;
+      IniStr strKey;
+      EType eType;
+      void *pVar;
+
+      DOUBLE dDefValue; // Default value of number types
+      CTString strDefValue; // Default value of strings
+
+      bool bClamp; // Limit number values to a range
+      DOUBLE dMin, dMax;
+    };
+
+    typedef se1::map<CIniText, size_t> BoundKeys;
+    typedef se1::map<IniStr, BoundKeys> BoundSections;
+
+    std::vector<Binding> m_aBindings;
+    BoundSections m_mapBound; // Bindings under each key
+
+    // State of the streaming reader
+    const BoundKeys *m_pSection; // Bound keys of the current section (NULL if there are none)
+    IniStr m_strKey; // Reused buffers for the current line
+    IniStr m_strValue;
+    ULONG m_ctSet; // Set variables during reading
+
+  public:
+    // Default constructor
+    CIniBindings() : m_pSection(NULL), m_ctSet(0)
+    {
+    };
+
+  private:
+    // Add a new binding or replace an existing one under the same key
+    Binding &Bind(const char *strSection, const char *strKey, EType eType, void *pVar) {
+      BoundKeys &keys = m_mapBound[strSection];
+      BoundKeys::_Pairib ib = keys.insert(BoundKeys::value_type(strKey, m_aBindings.size()));
+
+      if (ib.second) m_aBindings.push_back(Binding());
+
+      Binding &bind = m_aBindings[ib.first->second];
+      bind.strSection = strSection;
+      bind.strKey = strKey;
+      bind.eType = eType;
+      bind.pVar = pVar;
+      bind.dDefValue = 0.0;
+      bind.strDefValue = "";
+      bind.bClamp = false;
+      bind.dMin = bind.dMax = 0.0;
+
+      return bind;
+    };
+
+    // Add a number binding
+    void BindNumber(const char *strSection, const char *strKey, EType eType, void *pVar, DOUBLE dDefValue, bool bClamp, DOUBLE dMin, DOUBLE dMax) {
+      Binding &bind = Bind(strSection, strKey, eType, pVar);
+      bind.dDefValue = dDefValue;
+      bind.bClamp = bClamp;
+      bind.dMin = dMin;
+      bind.dMax = dMax;
+    };
+
+  public:
+    // Bind a boolean variable
+    void BindBool(const char *strSection, const char *strKey, bool *pbVar, bool bDefValue) {
+      BindNumber(strSection, strKey, E_BOOL, pbVar, bDefValue, false, 0, 0);
+    };
+
+    // Bind an integer variable
+    void BindInt(const char *strSection, const char *strKey, SLONG *piVar, SLONG iDefValue) {
+      BindNumber(strSection, strKey, E_INT, piVar, iDefValue, false, 0, 0);
+    };
+
+    // Bind an integer variable with limits
+    void BindInt(const char *strSection, const char *strKey, SLONG *piVar, SLONG iDefValue, SLONG iMin, SLONG iMax) {
+      BindNumber(strSection, strKey, E_INT, piVar, iDefValue, true, iMin, iMax);
+    };
+
+    // Bind a float variable
+    void BindFloat(const char *strSection, const char *strKey, FLOAT *pfVar, FLOAT fDefValue) {
+      BindNumber(strSection, strKey, E_FLOAT, pfVar, fDefValue, false, 0, 0);
+    };
+
+    // Bind a float variable with limits
+    void BindFloat(const char *strSection, const char *strKey, FLOAT *pfVar, FLOAT fDefValue, FLOAT fMin, FLOAT fMax) {
+      BindNumber(strSection, strKey, E_FLOAT, pfVar, fDefValue, true, fMin, fMax);
+    };
+
+    // Bind a double variable
+    void BindDouble(const char *strSection, const char *strKey, DOUBLE *pdVar, DOUBLE dDefValue) {
+      BindNumber(strSection, strKey, E_DOUBLE, pdVar, dDefValue, false, 0, 0);
+    };
+
+    // Bind a double variable with limits
+    void BindDouble(const char *strSection, const char *strKey, DOUBLE *pdVar, DOUBLE dDefValue, DOUBLE dMin, DOUBLE dMax) {
+      BindNumber(strSection, strKey, E_DOUBLE, pdVar, dDefValue, true, dMin, dMax);
+    };
+
+    // Bind a string variable
+    void BindString(const char *strSection, const char *strKey, CTString *pstrVar, const char *strDefValue = "") {
+      Bind(strSection, strKey, E_STRING, pstrVar).strDefValue = strDefValue;
+    };
+
+    // Remove all bindings
+    void Clear(void) {
+      m_aBindings.clear();
+      m_mapBound.clear();
+      m_pSection = NULL;
+    };
+
+    // Count bound variables
+    inline size_t Count(void) const {
+      return m_aBindings.size();
+    };
+
+  private:
+    // Limit a number to the range of a binding
+    static __forceinline DOUBLE Clamp(const Binding &bind, DOUBLE dValue) {
+      if (!bind.bClamp) return dValue;
+      if (dValue < bind.dMin) return bind.dMin;
+      if (dValue > bind.dMax) return bind.dMax;
+      return dValue;
+    };
+
+    // Set variable to its default value
+    static void SetDefault(const Binding &bind) {
+      switch (bind.eType) {
+        case E_BOOL:   *(bool   *)bind.pVar = (bind.dDefValue != 0.0); break;
+        case E_INT:    *(SLONG  *)bind.pVar = (SLONG)bind.dDefValue; break;
+        case E_FLOAT:  *(FLOAT  *)bind.pVar = (FLOAT)bind.dDefValue; break;
+        case E_DOUBLE: *(DOUBLE *)bind.pVar = bind.dDefValue; break;
+        case E_STRING: *(CTString *)bind.pVar = bind.strDefValue; break;
+      }
+    };
+
+    // Set variable from the text of a value (keeps the default value if the text is invalid)
+    static void SetFromText(const Binding &bind, const char *strValue) {
+      switch (bind.eType) {
+        case E_BOOL: {
+          bool bValue;
+          if (CIniValue::ConvertBool(strValue, bValue)) *(bool *)bind.pVar = bValue;
+        } break;
+
+        case E_INT: {
+          SLONG iValue;
+          if (CIniValue::ConvertInt(strValue, iValue)) *(SLONG *)bind.pVar = (SLONG)Clamp(bind, iValue);
+        } break;
+
+        case E_FLOAT: {
+          DOUBLE dValue;
+          if (CIniValue::ConvertDouble(strValue, dValue)) *(FLOAT *)bind.pVar = (FLOAT)Clamp(bind, dValue);
+        } break;
+
+        case E_DOUBLE: {
+          DOUBLE dValue;
+          if (CIniValue::ConvertDouble(strValue, dValue)) *(DOUBLE *)bind.pVar = Clamp(bind, dValue);
+        } break;
+
+        case E_STRING: *(CTString *)bind.pVar = strValue; break;
+      }
+    };
+
+    // Set variable from a config value (reuses values that have already been converted)
+    static void SetFromValue(const Binding &bind, const CIniValue &val, IniParseStats *pStats) {
+      switch (bind.eType) {
+        case E_BOOL: {
+          bool &bVar = *(bool *)bind.pVar;
+          bVar = val.GetBool(bVar, pStats);
+        } break;
+
+        case E_INT: {
+          SLONG &iVar = *(SLONG *)bind.pVar;
+          iVar = (SLONG)Clamp(bind, val.GetInt(iVar, pStats));
+        } break;
+
+        case E_FLOAT: {
+          FLOAT &fVar = *(FLOAT *)bind.pVar;
+          fVar = (FLOAT)Clamp(bind, val.GetDouble(fVar, pStats));
+        } break;
+
+        case E_DOUBLE: {
+          DOUBLE &dVar = *(DOUBLE *)bind.pVar;
+          dVar = Clamp(bind, val.GetDouble(dVar, pStats));
+        } break;
+
+        case E_STRING: *(CTString *)bind.pVar = val.c_str(); break;
+      }
+    };
+
+  public:
+    // Set all variables to their default values
+    void SetDefaults(void) const {
+      for (size_t i = 0; i < m_aBindings.size(); i++) {
+        SetDefault(m_aBindings[i]);
+      }
+    };
+
+    // Set all variables from a config in one pass through it (variables without keys are set to default values)
+    // Returns amount of variables that have been found in the config
+    // Conversions of values are counted in parse statistics of the config and reused by other reads from it
+    ULONG Apply(const CIniConfig &ini) const {
+      SetDefaults();
+
+      ULONG ctSet = 0;
+      IniParseStats *pStats = ini.ReadStats();
+
+      const IniSections &sections = ini.GetMap();
+      IniSections::const_iterator it;
+
+      for (it = sections.begin(); it != sections.end(); it++) {
+        BoundSections::const_iterator itBound = m_mapBound.find(it->first);
+        if (itBound == m_mapBound.end()) continue;
+
+        const BoundKeys &keys = itBound->second;
+        IniKeys::const_iterator itPair = it->second.begin();
+
+        for (; itPair != it->second.end(); itPair++) {
+          BoundKeys::const_iterator itKey = keys.find(itPair->first);
+          if (itKey == keys.end()) continue;
+
+          SetFromValue(m_aBindings[itKey->second], itPair->second, pStats);
+          ctSet++;
+        }
+      }
+
+      return ctSet;
+    };
+
+    // Prepare variables for being set by the streaming reader (called automatically by ApplyText() and ApplyFile_t())
+    void BeginReading(void) {
+      SetDefaults();
+      m_ctSet = 0;
+
+      // Keys before the first section
+      BoundSections::const_iterator it = m_mapBound.find(IniStr());
+      m_pSection = (it != m_mapBound.end()) ? &it->second : NULL;
+    };
+
+    // Set all variables directly from config text without loading it (variables without keys are set to default values)
+    // Returns amount of variables that have been found in the text
+    ULONG ApplyText(const char *pchText, const char *pchEnd) {
+      BeginReading();
+
+      CIniReader reader(*this);
+      reader.Parse(pchText, pchEnd);
+
+      return m_ctSet;
+    };
+
+    // Set all variables directly from a config file without loading it (variables without keys are set to default values)
+    // Returns amount of variables that have been found in the file
+    ULONG ApplyFile_t(const CTString &strFile, bool bEngineStreams) {
+      BeginReading();
+
+      CIniReader reader(*this);
+      reader.ParseFile_t(strFile, bEngineStreams);
+
+      return m_ctSet;
+    };
+
+    // Write all variables into a config
+    void Store(CIniConfig &ini) const {
+      for (size_t i = 0; i < m_aBindings.size(); i++) {
+        const Binding &bind = m_aBindings[i];
+        const char *strSection = bind.strSection.c_str();
+        const char *strKey = bind.strKey.c_str();
+
+        switch (bind.eType) {
+          case E_BOOL:   ini.SetBoolValue(strSection, strKey, *(bool *)bind.pVar); break;
+          case E_INT:    ini.SetIntValue(strSection, strKey, *(SLONG *)bind.pVar); break;
+          case E_FLOAT:  ini.SetDoubleValue(strSection, strKey, *(FLOAT *)bind.pVar); break;
+          case E_DOUBLE: ini.SetDoubleValue(strSection, strKey, *(DOUBLE *)bind.pVar); break;
+          case E_STRING: ini.SetValue(strSection, strKey, ((CTString *)bind.pVar)->str_String); break;
+        }
+      }
+    };
+
+  // Streaming reader handler
+  public:
+
+    virtual bool OnSection(const IniRange &rSection) {
+      m_strKey.assign(rSection.pchBeg, rSection.pchEnd);
+
+      BoundSections::const_iterator it = m_mapBound.find(m_strKey);
+      m_pSection = (it != m_mapBound.end()) ? &it->second : NULL;
+
+      return true;
+    };
+
+    virtual bool OnKey(const IniRange &, const IniRange &rKey, const IniRange &rValue) {
+      if (m_pSection == NULL) return true;
+
+      m_strKey.assign(rKey.pchBeg, rKey.pchEnd);
+
+      BoundKeys::const_iterator itKey = m_pSection->find(CIniText(CIniText::E_REFERENCE, m_strKey));
+      if (itKey == m_pSection->end()) return true;
+
+      m_strValue.assign(rValue.pchBeg, rValue.pchEnd);
+      SetFromText(m_aBindings[itKey->second], m_strValue.c_str());
+
+      m_ctSet++;
+      return true;
+    };
+
+    virtual void OnEnd(void) {
+      m_pSection = NULL;
+    };
+};
+
+#endif
@@ -21,29 +21,590 @@ with this program; if not, write to the Free Software Foundation, Inc.,
 #endif
 
 #include "../Objects/MapStructure.h"
+#include "../Objects/Arena.h"
 #include "../Interfaces/Directories.h"
 
 #include "../Base/STLIncludesBegin.h"
 #include <string>
-#include <fstream>
 #include <sstream>
+#include <vector>
 #include "../Base/STLIncludesEnd.h"
 
 // Uses STL internally for convenience but user input/output is CTString
 typedef std::string IniStr;
 
-typedef se1::map<IniStr, IniStr> IniKeys;
+// Range of characters within some text
+struct IniRange {
+  const char *pchBeg;
+  const char *pchEnd;
+
+  inline size_t Length(void) const { return pchEnd - pchBeg; };
+};
+
+// Statistics of reading typed values from the config
+struct IniParseStats {
+  ULONG ctParses; // Values converted from text
+  ULONG ctHits; // Values taken from the cache
+
+  IniParseStats() : ctParses(0), ctHits(0) {};
+};
+
+// Text of config keys and values that can be stored in an arena
+// Copies of stored text always keep their own text on the heap, so they stay valid after the arena of the original is reset.
+// Assigned text is kept where the previous text has been, so text that's been put into an arena stays in it.
+class CIniText {
+  public:
+    // Tag for referencing existing text instead of copying it
+    enum EReference { E_REFERENCE };
+
+  private:
+    const char *m_pchText; // Null-terminated text
+    size_t m_ctLength;
+    se1::arena *m_pArena; // Storage of assigned text (NULL for the heap)
+    bool m_bHeap; // Text has been allocated on the heap
+
+  private:
+    // Copy text into own storage without freeing the previous one
+    void Copy(const char *pch, size_t ct) {
+      // Empty text doesn't need any memory
+      if (ct == 0) {
+        m_pchText = "";
+        m_ctLength = 0;
+        m_bHeap = false;
+        return;
+      }
+
+      char *pchCopy;
+
+      if (m_pArena != NULL) {
+        pchCopy = (char *)m_pArena->allocate(ct + 1);
+        m_bHeap = false;
+
+      } else {
+        pchCopy = (char *)malloc(ct + 1);
+        if (pchCopy == NULL) throw std::bad_alloc();
+        m_bHeap = true;
+      }
+
+      memcpy(pchCopy, pch, ct);
+      pchCopy[ct] = '\0';
+
+      m_pchText = pchCopy;
+      m_ctLength = ct;
+    };
+
+    // Replace text with a copy of another one
+    void Assign(const char *pch, size_t ct) {
+      const char *pchOld = m_pchText;
+      const bool bOldHeap = m_bHeap;
+
+      // Free the previous text only after copying, in case it's the same
+      Copy(pch, ct);
+      if (bOldHeap) free((void *)pchOld);
+    };
+
+  public:
+    // Default constructor
+    CIniText() : m_pchText(""), m_ctLength(0), m_pArena(NULL), m_bHeap(false) {};
+
+    // Constructors that copy text onto the heap
+    CIniText(const char *str) : m_pArena(NULL) { Copy(str, strlen(str)); };
+    CIniText(const char *pch, size_t ct) : m_pArena(NULL) { Copy(pch, ct); };
+    CIniText(const IniStr &str) : m_pArena(NULL) { Copy(str.c_str(), str.length()); };
+
+    // Constructors that reference text without copying it (e.g. for looking up keys)
+    // Copies of references are references as well, so the text must outlive all of them!
+    CIniText(EReference, const char *str) : m_pchText(str), m_ctLength(strlen(str)), m_pArena(NULL), m_bHeap(false) {};
+    CIniText(EReference, const IniStr &str) : m_pchText(str.c_str()), m_ctLength(str.length()), m_pArena(NULL), m_bHeap(false) {};
+    CIniText(EReference, const CIniText &str) : m_pchText(str.m_pchText), m_ctLength(str.m_ctLength), m_pArena(NULL), m_bHeap(false) {};
+
+    // Copy constructor
+    CIniText(const CIniText &other) : m_pArena(NULL) {
+      if (other.IsReference()) {
+        m_pchText = other.m_pchText;
+        m_ctLength = other.m_ctLength;
+        m_bHeap = false;
+      } else {
+        Copy(other.m_pchText, other.m_ctLength);
+      }
+    };
+
+    // Destructor
+    ~CIniText() {
+      if (m_bHeap) free((void *)m_pchText);
+    };
+
+    // Assignment (keeps own storage)
+    CIniText &operator=(const CIniText &other) {
+      if (this != &other) Assign(other.m_pchText, other.m_ctLength);
+      return *this;
+    };
+
+    CIniText &operator=(const char *str) {
+      Assign(str, strlen(str));
+      return *this;
+    };
+
+    CIniText &operator=(const IniStr &str) {
+      Assign(str.c_str(), str.length());
+      return *this;
+    };
+
+    // Make sure the text is stored in a specific arena (or on the heap, if it's NULL) and keep assigning it there
+    // Used for putting text into its final storage after referencing it
+    void Keep(se1::arena *pArena) {
+      if (m_pArena == pArena && !IsReference()) return;
+
+      const char *pchOld = m_pchText;
+      const bool bOldHeap = m_bHeap;
+
+      m_pArena = pArena;
+      Copy(pchOld, m_ctLength);
+      if (bOldHeap) free((void *)pchOld);
+    };
+
+    // Check if the text is only referenced
+    inline bool IsReference(void) const {
+      return !m_bHeap && m_pArena == NULL && m_ctLength != 0;
+    };
+
+    // Check if the text is stored in an arena
+    inline bool IsInArena(void) const {
+      return m_pArena != NULL && m_ctLength != 0;
+    };
+
+    inline const char *c_str(void) const { return m_pchText; };
+    inline size_t length(void) const { return m_ctLength; };
+    inline size_t size(void) const { return m_ctLength; };
+    inline bool empty(void) const { return m_ctLength == 0; };
+    inline char operator[](size_t i) const { return m_pchText[i]; };
+
+    // Copy into an STL string
+    inline IniStr ToStr(void) const { return IniStr(m_pchText, m_ctLength); };
+
+    // Convert into an STL string for code that treats keys and values of config maps as IniStr
+    inline operator IniStr() const { return ToStr(); };
+
+    // Compare text with other strings
+    inline bool Equals(const char *pch, size_t ct) const {
+      return m_ctLength == ct && memcmp(m_pchText, pch, ct) == 0;
+    };
+
+    inline bool operator==(const CIniText &other) const { return Equals(other.m_pchText, other.m_ctLength); };
+    inline bool operator!=(const CIniText &other) const { return !Equals(other.m_pchText, other.m_ctLength); };
+    inline bool operator==(const IniStr &str) const { return Equals(str.c_str(), str.length()); };
+    inline bool operator!=(const IniStr &str) const { return !Equals(str.c_str(), str.length()); };
+    inline bool operator==(const char *str) const { return Equals(str, strlen(str)); };
+    inline bool operator!=(const char *str) const { return !Equals(str, strlen(str)); };
+};
+
+namespace se1 {
+
+// Config text is hashed the same way as STL strings
+template<>
+struct map_hash<CIniText> {
+  size_t operator()(const CIniText &key) const { return HashChars(key.c_str(), key.length()); };
+};
+
+}; // namespace
+
+// Config value that remembers its text converted into other types
+// Text is only accessible for reading and can only be changed by assigning a new one, which resets the cache
+class CIniValue {
+  public:
+    // Types of cached values
+    enum ECached {
+      E_CACHED_BOOL   = (1 << 0),
+      E_CACHED_INT    = (1 << 1),
+      E_CACHED_DOUBLE = (1 << 2),
+    };
+
+  private:
+    CIniText m_text;
+
+    mutable UBYTE m_ubCached; // Types that have been converted
+    mutable UBYTE m_ubValid; // Types that have been converted successfully
+
+    mutable bool m_bValue;
+    mutable SLONG m_iValue;
+    mutable DOUBLE m_dValue;
+
+  public:
+    // Default constructor
+    CIniValue() : m_ubCached(0), m_ubValid(0), m_bValue(false), m_iValue(0), m_dValue(0.0) {};
+
+    // Constructors from text
+    CIniValue(const CIniText &str) : m_text(str), m_ubCached(0), m_ubValid(0), m_bValue(false), m_iValue(0), m_dValue(0.0) {};
+    CIniValue(const IniStr &str) : m_text(str), m_ubCached(0), m_ubValid(0), m_bValue(false), m_iValue(0), m_dValue(0.0) {};
+    CIniValue(const char *str) : m_text(str), m_ubCached(0), m_ubValid(0), m_bValue(false), m_iValue(0), m_dValue(0.0) {};
+
+    // Assign new text and reset cached values
+    CIniValue &operator=(const IniStr &str) {
+      m_text = str;
+      m_ubCached = 0;
+      return *this;
+    };
+
+    // Assign new text and reset cached values
+    CIniValue &operator=(const char *str) {
+      m_text = str;
+      m_ubCached = 0;
+      return *this;
+    };
+
+    // Make sure the text is stored in a specific arena (or on the heap, if it's NULL) and keep assigning text there
+    inline void Keep(se1::arena *pArena) {
+      m_text.Keep(pArena);
+    };
+
+    // Read-only access to the text
+    inline const char *c_str(void) const { return m_text.c_str(); };
+    inline size_t length(void) const { return m_text.length(); };
+    inline size_t size(void) const { return m_text.size(); };
+    inline bool empty(void) const { return m_text.empty(); };
+
+    // Get the text
+    inline const CIniText &GetText(void) const {
+      return m_text;
+    };
+
+    // Convert into an STL string for code that treats values of config maps as IniStr
+    inline operator IniStr() const { return m_text.ToStr(); };
+
+    // Compare text with other values
+    inline bool operator==(const CIniValue &other) const { return m_text == other.m_text; };
+    inline bool operator!=(const CIniValue &other) const { return m_text != other.m_text; };
+    inline bool operator==(const IniStr &str) const { return m_text == str; };
+    inline bool operator!=(const IniStr &str) const { return m_text != str; };
+    inline bool operator==(const char *str) const { return m_text == str; };
+    inline bool operator!=(const char *str) const { return m_text != str; };
+
+  private:
+    // Remember converted value of a specific type
+    template<class Type> __forceinline
+    void Cache(ECached eType, Type &valCache, const Type &val, bool bValid) const {
+      // Mark the type as cached only after its value is in place
+      if (bValid) {
+        valCache = val;
+        m_ubValid |= eType;
+      } else {
+        m_ubValid &= ~eType;
+      }
+
+      m_ubCached |= eType;
+    };
+
+  public:
+    // Remember values that have been set directly
+    inline void CacheBool(bool bValue) const { Cache(E_CACHED_BOOL, m_bValue, bValue, true); };
+    inline void CacheInt(SLONG iValue) const { Cache(E_CACHED_INT, m_iValue, iValue, true); };
+    inline void CacheDouble(DOUBLE dValue) const { Cache(E_CACHED_DOUBLE, m_dValue, dValue, true); };
+
+    // Convert text into all types at once, so reading them afterwards doesn't change anything
+    void CacheAll(void) const {
+      GetBool(false, NULL);
+      GetInt(0, NULL);
+      GetDouble(0.0, NULL);
+    };
+
+    // Check if text has been converted into all types
+    inline bool IsFullyCached(void) const {
+      return m_ubCached == (E_CACHED_BOOL | E_CACHED_INT | E_CACHED_DOUBLE);
+    };
+
+    // Get boolean value or return a default value, if the text isn't a boolean
+    // Conversions and cache hits are counted in the statistics, if there are any
+    bool GetBool(bool bDefValue, IniParseStats *pStats) const {
+      if (m_ubCached & E_CACHED_BOOL) {
+        if (pStats != NULL) ++pStats->ctHits;
+      } else {
+        if (pStats != NULL) ++pStats->ctParses;
+        bool bValue = false;
+        const bool bValid = ConvertBool(c_str(), bValue);
+        Cache(E_CACHED_BOOL, m_bValue, bValue, bValid);
+      }
+
+      return (m_ubValid & E_CACHED_BOOL) ? m_bValue : bDefValue;
+    };
+
+    // Get integer value or return a default value, if the text isn't an integer
+    SLONG GetInt(SLONG iDefValue, IniParseStats *pStats) const {
+      if (m_ubCached & E_CACHED_INT) {
+        if (pStats != NULL) ++pStats->ctHits;
+      } else {
+        if (pStats != NULL) ++pStats->ctParses;
+        SLONG iValue = 0;
+        const bool bValid = ConvertInt(c_str(), iValue);
+        Cache(E_CACHED_INT, m_iValue, iValue, bValid);
+      }
+
+      return (m_ubValid & E_CACHED_INT) ? m_iValue : iDefValue;
+    };
+
+    // Get float value or return a default value, if the text isn't a number
+    DOUBLE GetDouble(DOUBLE dDefValue, IniParseStats *pStats) const {
+      if (m_ubCached & E_CACHED_DOUBLE) {
+        if (pStats != NULL) ++pStats->ctHits;
+      } else {
+        if (pStats != NULL) ++pStats->ctParses;
+        DOUBLE dValue = 0.0;
+        const bool bValid = ConvertDouble(c_str(), dValue);
+        Cache(E_CACHED_DOUBLE, m_dValue, dValue, bValid);
+      }
+
+      return (m_ubValid & E_CACHED_DOUBLE) ? m_dValue : dDefValue;
+    };
+
+  public:
+    // Determine boolean value from the beginning of a string
+    static bool ConvertBool(const char *str, bool &bValue) {
+      char ch = toupper(str[0]); // First character
+
+      switch (ch) {
+        // True values
+        case 'T': case 'Y': case '1': bValue = true; return true;
+
+        // False values
+        case 'F': case 'N': case '0': bValue = false; return true;
+
+        // On/Off
+        case 'O': {
+          // This is either '\0' or another character
+          ch = toupper(str[1]); // Second character
+
+          if (ch == 'N') { bValue = true; return true; }
+          if (ch == 'F') { bValue = false; return true; }
+        } break;
+      }
+
+      return false;
+    };
+
+    // Determine integer value from the string
+    static bool ConvertInt(const char *str, SLONG &iValue) {
+      char *pSuffix;
+      iValue = strtol(str, &pSuffix, 0);
+
+      return pSuffix != NULL && *pSuffix == '\0';
+    };
+
+    // Determine float value from the string
+    static bool ConvertDouble(const char *str, DOUBLE &dValue) {
+      char *pSuffix;
+      dValue = strtod(str, &pSuffix);
+
+      return pSuffix != NULL && *pSuffix == '\0';
+    };
+};
+
+// Key-value pair of a config
+// NOTE: Keys and values used to be IniStr. They convert into IniStr implicitly, but std::string methods other than c_str(),
+// length(), size() and empty() need ToStr() or GetText().ToStr() now, as well as STL operators that are templates.
+typedef std::pair<CIniText, CIniValue> IniPair;
+
+// Keys of each section with their text can be allocated from an arena of their config
+typedef se1::arena_allocator<IniPair> IniKeysAlloc;
+typedef se1::map<CIniText, CIniValue, se1::map_hash<CIniText>, IniKeysAlloc> IniKeys;
+
+// Sections and their names aren't allocated from the arena, since configs only have a few of them and section names are
+// passed around as IniStr by change callbacks, overlays and bindings
 typedef se1::map<IniStr, IniKeys> IniSections;
 
+class CIniKeyHandle;
+class CIniOverlay;
+class CIniBindings;
+
+// Types of key changes between two states of a config
+enum EIniChange {
+  E_INI_ADDED,   // New key
+  E_INI_CHANGED, // Different value of an existing key
+  E_INI_REMOVED, // Key doesn't exist anymore
+};
+
+// Function that receives changes of individual keys (old value is empty for new keys and new value is empty for removed ones)
+typedef void (*FIniChangeCallback)(EIniChange eChange, const IniStr &strSection, const CIniText &strKey,
+  const CIniText &strOldValue, const CIniText &strNewValue, void *pUserData);
+
 // INI config structure
 class CIniConfig : protected IniSections {
+  private:
+    friend class CIniKeyHandle;
+    friend class CIniOverlay;
+    friend class CIniBindings;
+
+    // Incremented whenever keys or sections are added or removed
+    ULONG m_ulGeneration;
+
+    // Statistics of reading typed values
+    mutable IniParseStats m_stats;
+
+    // Storage of all key-value pairs (NULL if each one is allocated separately)
+    se1::arena *m_pArena;
+
+    // All values have been converted beforehand and nothing can be changed anymore
+    bool m_bFrozen;
+
+    // Text of a section from the last incremental save
+    struct SavedSection {
+      IniStr strText;
+      bool bDirty; // Section has changed since then
+
+      SavedSection() : bDirty(true) {};
+    };
+
+    se1::map<IniStr, SavedSection> m_mapSaved; // Sections from the last incremental save
+    IniStr m_strSaveBuffer; // Text of the entire config from the last incremental save
+    CTString m_strSavedFile; // File of the last incremental save
+    bool m_bUnsaved; // Anything has changed since the last incremental save
+
+    // Mark that existing keys may have moved
+    __forceinline void ChangeStructure(void) {
+      ASSERT(!m_bFrozen);
+      ++m_ulGeneration;
+    };
+
+    // Mark that keys of some section have changed since the last save
+    void ChangeSection(const IniStr &strSection) {
+      ASSERT(!m_bFrozen);
+      m_bUnsaved = true;
+      if (m_mapSaved.empty()) return;
+
+      se1::map<IniStr, SavedSection>::iterator it = m_mapSaved.find(strSection);
+      if (it != m_mapSaved.end()) it->second.bDirty = true;
+    };
+
+    // Mark that some section has been removed since the last save
+    void RemoveSection(const IniStr &strSection) {
+      ASSERT(!m_bFrozen);
+      m_bUnsaved = true;
+      if (m_mapSaved.empty()) return;
+
+      se1::map<IniStr, SavedSection>::iterator it = m_mapSaved.find(strSection);
+      if (it != m_mapSaved.end()) m_mapSaved.erase(it);
+    };
+
+    // Mark that anything may have changed since the last save
+    void ChangeAllSections(void) {
+      ASSERT(!m_bFrozen);
+      m_mapSaved.clear();
+      m_bUnsaved = true;
+    };
+
+    // Get statistics for counting reads of typed values
+    // Frozen configs don't count anything, so reading them from multiple threads doesn't write into them
+    __forceinline IniParseStats *ReadStats(void) const {
+      return m_bFrozen ? NULL : &m_stats;
+    };
+
+    // Create an empty list of keys for a new section
+    __forceinline IniKeys NewKeys(void) const { return IniKeys(IniKeysAlloc(m_pArena)); };
+
+    // Pair that references text of a key and its value until it's put into own storage
+    template<class Type> static __forceinline
+    IniPair ReferencePair(const Type &strKey, const Type &strValue) {
+      return IniPair(CIniText(CIniText::E_REFERENCE, strKey), CIniValue(CIniText(CIniText::E_REFERENCE, strValue)));
+    };
+
+    // Put text of a new key-value pair into own storage
+    __forceinline void KeepPair(IniPair &pair) const {
+      pair.first.Keep(m_pArena);
+      pair.second.Keep(m_pArena);
+    };
+
+    // Copy all sections from another config into own storage
+    void CopySections(const CIniConfig &iniOther) {
+      for (const_iterator it = iniOther.begin(); it != iniOther.end(); ++it) {
+        IniKeys &keys = insert(value_type(it->first, NewKeys())).first->second;
+        keys = it->second;
+
+        for (IniKeys::iterator itPair = keys.begin(); itPair != keys.end(); ++itPair) {
+          KeepPair(*itPair);
+        }
+      }
+    };
+
   public:
+    // Default constructor
+    CIniConfig() : m_ulGeneration(0), m_pArena(NULL), m_bFrozen(false), m_bUnsaved(true) {};
+
+    // Constructor that allocates all key-value pairs and their text from blocks of a specific size
+    // Memory of removed keys and replaced values is only reclaimed by clearing the entire config, so it suits configs that are mostly loaded and read
+    // NOTE: Sections and their names are still allocated separately!
+    explicit CIniConfig(size_t ctArenaBlock) : m_ulGeneration(0), m_pArena(new se1::arena(ctArenaBlock)), m_bFrozen(false), m_bUnsaved(true) {};
+
+    // Copy constructor (the copy has its own storage of the same kind)
+    CIniConfig(const CIniConfig &iniOther) : IniSections(), m_ulGeneration(0), m_stats(iniOther.m_stats),
+      m_pArena(iniOther.m_pArena != NULL ? new se1::arena(iniOther.m_pArena->block_size()) : NULL), m_bFrozen(false), m_bUnsaved(true)
+    {
+      CopySections(iniOther);
+    };
+
+    // Destructor
+    ~CIniConfig() {
+      // Keys have to be destroyed while their storage still exists
+      clear();
+      delete m_pArena;
+    };
+
+    // Assignment (keeps own storage)
+    CIniConfig &operator=(const CIniConfig &iniOther) {
+      if (this != &iniOther) {
+        Clear();
+        CopySections(iniOther);
+        m_stats = iniOther.m_stats;
+      }
+      return *this;
+    };
+
+    // Check if key-value pairs are allocated from an arena
+    inline bool UsesArena(void) const { return m_pArena != NULL; };
+
+    // Convert all values into all types and forbid any further changes
+    // Reading a frozen config doesn't write anything into it, so it can be read from multiple threads at once.
+    // Parse statistics aren't counted for it either.
+    void Freeze(void) {
+      for (const_iterator it = begin(); it != end(); ++it) {
+        IniKeys::const_iterator itPair = it->second.begin();
+
+        for (; itPair != it->second.end(); ++itPair) {
+          itPair->second.CacheAll();
+        }
+      }
+
+      m_bFrozen = true;
+    };
+
+    // Check if the config has been frozen
+    inline bool IsFrozen(void) const { return m_bFrozen; };
+
     // Explicit cast into the underlying map type
-    IniSections &GetMap(void) { return static_cast<IniSections &>(*this); };
+    // Any key or section may be added or removed through the map, so handles have to resolve them again
+    IniSections &GetMap(void) {
+      ChangeStructure();
+      ChangeAllSections();
+      return static_cast<IniSections &>(*this);
+    };
     const IniSections &GetMap(void) const { return static_cast<const IniSections &>(*this); };
 
+    // Get current generation of the config structure
+    inline ULONG GetGeneration(void) const { return m_ulGeneration; };
+
+    // Get statistics of reading typed values
+    inline const IniParseStats &GetParseStats(void) const { return m_stats; };
+
+    // Reset statistics of reading typed values
+    inline void ResetParseStats(void) { m_stats = IniParseStats(); };
+
     // Clear the config
-    inline void Clear(void) { clear(); };
+    inline void Clear(void) {
+      clear();
+
+      // Reuse the storage since nothing references it anymore
+      if (m_pArena != NULL) m_pArena->reset();
+
+      ChangeStructure();
+      ChangeAllSections();
+    };
 
     // Check if config is empty
     inline bool IsEmpty(void) const { return empty(); };
@@ -55,11 +616,7 @@ class CIniConfig : protected IniSections {
 
     // Check if some key exists under some section
     bool KeyExists(const char *strSection, const char *strKey) const {
-      const_iterator it = find(strSection);
-      if (it == end()) return false;
-
-      IniKeys::const_iterator itPair = it->second.find(strKey);
-      return itPair != it->second.end();
+      return FindValue(strSection, strKey) != NULL;
     };
 
     // Delete key under some section or the entire section (if strKey is NULL)
@@ -70,299 +627,716 @@ class CIniConfig : protected IniSections {
 
       // Delete section
       if (strKey == NULL) {
+        RemoveSection(it->first);
         erase(it);
+        ChangeStructure();
         return true;
       }
 
       IniKeys &keys = it->second;
 
       // No key
-      IniKeys::iterator itPair = keys.find(strKey);
+      IniKeys::iterator itPair = keys.find(CIniText(CIniText::E_REFERENCE, strKey));
       if (itPair == keys.end()) return false;
 
       // Delete key
       keys.erase(itPair);
+      ChangeStructure();
+      ChangeSection(it->first);
       return true;
     };
 
-  public:
-    // Set value to a key under some section
-    void SetValue(const char *strSection, const char *strKey, const char *strValue) {
+    // Find value of a key under some section (returns NULL if key or section doesn't exist)
+    const CIniValue *FindValue(const IniStr &strSection, const CIniText &strKey) const {
+      const_iterator it = find(strSection);
+      if (it == end()) return NULL;
+
+      const IniKeys &pairs = it->second;
+
+      IniKeys::const_iterator itPair = pairs.find(strKey);
+      if (itPair == pairs.end()) return NULL;
+
+      return &itPair->second;
+    };
+
+    // Find value of a key under some section (returns NULL if key or section doesn't exist)
+    inline const CIniValue *FindValue(const IniStr &strSection, const IniStr &strKey) const {
+      return FindValue(strSection, CIniText(CIniText::E_REFERENCE, strKey));
+    };
+
+    // Find value of a key under some section (returns NULL if key or section doesn't exist)
+    inline const CIniValue *FindValue(const char *strSection, const char *strKey) const {
+      return FindValue(IniStr(strSection), CIniText(CIniText::E_REFERENCE, strKey));
+    };
+
+  private:
+    // Set value to a key under some section and return it
+    const CIniValue &SetValueRef(const char *strSection, const char *strKey, const char *strValue) {
+      ASSERT(!m_bFrozen);
+
       // Create new section, if there isn't the one needed
       iterator it = find(strSection);
-      if (it == end()) it = insert(value_type(strSection, IniKeys())).first;
+      if (it == end()) it = insert(value_type(strSection, NewKeys())).first;
 
       // Insert a new key-value pair or find an existing one
-      IniKeys::_Pairib ib = it->second.insert(IniKeys::value_type(strKey, strValue));
+      IniKeys::_Pairib ib = it->second.insert(ReferencePair<const char *>(strKey, strValue));
 
-      // Update value of the existing key
+      // Update value of the existing key, if it's different
       if (!ib.second) {
-        ib.first->second = strValue;
+        if (ib.first->second != strValue) {
+          ib.first->second = strValue;
+          ChangeSection(it->first);
+        }
+
+      } else {
+        KeepPair(*ib.first);
+        ChangeStructure();
+        ChangeSection(it->first);
       }
+
+      return ib.first->second;
+    };
+
+  public:
+    // Set value to a key under some section
+    inline void SetValue(const char *strSection, const char *strKey, const char *strValue) {
+      SetValueRef(strSection, strKey, strValue);
     };
 
     // Set boolean value under a key under some section
     inline void SetBoolValue(const char *strSection, const char *strKey, bool bValue) {
-      SetValue(strSection, strKey, bValue ? "1" : "0");
+      SetValueRef(strSection, strKey, bValue ? "1" : "0").CacheBool(bValue);
     };
 
     // Set integer value under a key under some section
     inline void SetIntValue(const char *strSection, const char *strKey, SLONG iValue) {
       char strValue[256];
       sprintf(strValue, "%d", iValue);
-      SetValue(strSection, strKey, strValue);
+      SetValueRef(strSection, strKey, strValue).CacheInt(iValue);
     };
 
     // Set float value under a key under some section
+    // The exact value is remembered for reading it back instead of the rounded text
     inline void SetDoubleValue(const char *strSection, const char *strKey, DOUBLE dValue) {
       char strValue[256];
       sprintf(strValue, "%f", dValue);
-      SetValue(strSection, strKey, strValue);
+      SetValueRef(strSection, strKey, strValue).CacheDouble(dValue);
     };
 
     // Get value under a key or return a default value, if key or section doesn't exist
     CTString GetValue(const char *strSection, const char *strKey, const char *strDefValue = "") const {
-      const_iterator it = find(strSection);
-      if (it == end()) return strDefValue;
-
-      const IniKeys &pairs = it->second;
-
-      IniKeys::const_iterator itPair = pairs.find(strKey);
-      if (itPair == pairs.end()) return strDefValue;
+      const CIniValue *pval = FindValue(strSection, strKey);
+      if (pval == NULL) return strDefValue;
 
-      return itPair->second.c_str();
+      return pval->c_str();
     };
 
     // Get boolean value under a key or return a default value, if key or section doesn't exist
     bool GetBoolValue(const char *strSection, const char *strKey, bool bDefValue) const {
-      const_iterator it = find(strSection);
-      if (it == end()) return bDefValue;
-
-      const IniKeys &pairs = it->second;
-
-      IniKeys::const_iterator itPair = pairs.find(strKey);
-      if (itPair == pairs.end()) return bDefValue;
-
-      // Determine boolean value from the beginning of a string
-      const IniStr &str = itPair->second;
-      char ch = toupper(str[0]); // First character
-
-      switch (ch) {
-        // True values
-        case 'T': case 'Y': case '1': return true;
+      const CIniValue *pval = FindValue(strSection, strKey);
+      if (pval == NULL) return bDefValue;
 
-        // False values
-        case 'F': case 'N': case '0': return false;
-
-        // On/Off
-        case 'O': {
-          // This is either '\0' or another character
-          ch = toupper(str[1]); // Second character
-
-          if (ch == 'N') return true;
-          if (ch == 'F') return false;
-        } break;
-      }
-
-      return bDefValue;
+      return pval->GetBool(bDefValue, ReadStats());
     };
 
     // Get integer value under a key or return a default value, if key or section doesn't exist
     SLONG GetIntValue(const char *strSection, const char *strKey, SLONG iDefValue) const {
-      const_iterator it = find(strSection);
-      if (it == end()) return iDefValue;
-
-      const IniKeys &pairs = it->second;
+      const CIniValue *pval = FindValue(strSection, strKey);
+      if (pval == NULL) return iDefValue;
 
-      IniKeys::const_iterator itPair = pairs.find(strKey);
-      if (itPair == pairs.end()) return iDefValue;
+      return pval->GetInt(iDefValue, ReadStats());
+    };
 
-      // Determine integer value from the string
-      char *pSuffix;
-      SLONG iValue = strtol(itPair->second.c_str(), &pSuffix, 0);
+    // Get float value under a key or return a default value, if key or section doesn't exist
+    DOUBLE GetDoubleValue(const char *strSection, const char *strKey, DOUBLE dDefValue) const {
+      const CIniValue *pval = FindValue(strSection, strKey);
+      if (pval == NULL) return dDefValue;
 
-      if (pSuffix == NULL || *pSuffix != '\0') return iDefValue;
+      return pval->GetDouble(dDefValue, ReadStats());
+    };
 
-      return iValue;
+  public:
+    // Types of config lines
+    enum ELineType {
+      E_LINE_NONE = 0, // Empty or unrecognized line
+      E_LINE_SECTION,  // Section name in square brackets
+      E_LINE_KEY,      // Key and value around the assignment operator
     };
 
-    // Get float value under a key or return a default value, if key or section doesn't exist
-    DOUBLE GetDoubleValue(const char *strSection, const char *strKey, DOUBLE dDefValue) const {
-      const_iterator it = find(strSection);
-      if (it == end()) return dDefValue;
+    // Check if a character is a space that should be trimmed
+    static __forceinline bool IsSpace(char ch) {
+      return ch == ' ' || ch == '\t';
+    };
 
-      const IniKeys &pairs = it->second;
+    // Split config line into a section name or a key and a value without copying anything
+    // Resulting ranges point into the line itself and are only valid for as long as the line is
+    static ELineType SplitLine(const char *pchLine, const char *pchEnd, IniRange &rName, IniRange &rValue) {
+      // Skip empty lines
+      const char *pchBeg = pchLine;
+      while (pchBeg != pchEnd && IsSpace(*pchBeg)) ++pchBeg;
 
-      IniKeys::const_iterator itPair = pairs.find(strKey);
-      if (itPair == pairs.end()) return dDefValue;
+      if (pchBeg == pchEnd) return E_LINE_NONE;
 
-      // Determine float value from the string
-      char *pSuffix;
-      DOUBLE dValue = strtod(itPair->second.c_str(), &pSuffix);
+      // Parse a group name if it's enclosed in square brackets
+      if (*pchBeg == '[') {
+        // Search for the closing bracket at the end
+        const char *pchLast = pchEnd - 1;
+        while (IsSpace(*pchLast)) --pchLast;
+
+        if (*pchLast == ']') {
+          rName.pchBeg = pchBeg + 1;
+          rName.pchEnd = pchLast;
+          return E_LINE_SECTION;
+        }
+      }
 
-      if (pSuffix == NULL || *pSuffix != '\0') return dDefValue;
+      // Get key and value separator
+      const char *pchSeparator = pchBeg;
+      while (pchSeparator != pchEnd && *pchSeparator != '=') ++pchSeparator;
+
+      if (pchSeparator == pchEnd) return E_LINE_NONE;
+
+      // Trim spaces after the key
+      rName.pchBeg = pchBeg;
+      rName.pchEnd = pchSeparator;
+      while (rName.pchEnd != rName.pchBeg && IsSpace(rName.pchEnd[-1])) --rName.pchEnd;
+
+      // Trim spaces around the value
+      rValue.pchBeg = pchSeparator + 1;
+      rValue.pchEnd = pchEnd;
+      while (rValue.pchBeg != rValue.pchEnd && IsSpace(*rValue.pchBeg)) ++rValue.pchBeg;
+      while (rValue.pchEnd != rValue.pchBeg && IsSpace(rValue.pchEnd[-1])) --rValue.pchEnd;
+
+      // Remove surrounding quotes
+      if (rValue.Length() > 1) {
+        if (*rValue.pchBeg == '\"') ++rValue.pchBeg;
+        if (rValue.pchEnd[-1] == '\"') --rValue.pchEnd;
+      }
 
-      return dValue;
+      return E_LINE_KEY;
     };
 
-  public:
     // Parse config line and set key and value in a specific section, if it isn't a section line
-    bool ParseLine(const IniStr &strLine, IniStr &strSection) {
-      #define FIND_SPACES " \t"
+    bool ParseLine(const char *pchLine, const char *pchEnd, IniStr &strSection) {
+      IniRange rName, rValue;
 
-      // Skip empty lines
-      size_t iBeg = strLine.find_first_not_of(FIND_SPACES);
-      if (iBeg == IniStr::npos) return false;
+      switch (SplitLine(pchLine, pchEnd, rName, rValue)) {
+        // Just change the group
+        case E_LINE_SECTION:
+          strSection.assign(rName.pchBeg, rName.pchEnd);
+          return false;
 
-      // Parse a group name if it's enclosed in square brackets
-      if (strLine[iBeg] == '[') {
-        // Skip opening bracket and search for the closing one
-        size_t iEnd = strLine.find_last_not_of(FIND_SPACES);
+        case E_LINE_KEY: {
+          const IniStr strKey(rName.pchBeg, rName.pchEnd);
+          const IniStr strVal(rValue.pchBeg, rValue.pchEnd);
 
-        if (strLine[iEnd] == ']') {
-          // Just change the group
-          strSection = strLine.substr(iBeg + 1, iEnd - iBeg - 1).c_str();
-          return false;
-        }
+          SetValue(strSection.c_str(), strKey.c_str(), strVal.c_str());
+        } return true;
       }
 
-      // Get key and value separator
-      size_t iSeparator = strLine.find('=');
-      if (iSeparator == IniStr::npos) return false;
-
-      // Get key and value around the assignment operator
-      IniStr strKey = strLine.substr(0, iSeparator);
-      IniStr strVal = strLine.substr(iSeparator + 1);
-
-      {
-        // Trim spaces around the key
-        size_t iEnd = strKey.find_last_not_of(FIND_SPACES);
-        strKey = strKey.substr(iBeg, iEnd - iBeg + 1);
-
-        // Trim spaces around the value
-        iBeg = strVal.find_first_not_of(FIND_SPACES);
-        iEnd = strVal.find_last_not_of(FIND_SPACES);
-
-        // Remove surrounding quotes
-        if (iBeg != IniStr::npos && iEnd != IniStr::npos && iBeg != iEnd) {
-          if (strVal[iBeg] == '\"') iBeg++;
-          if (strVal[iEnd] == '\"') iEnd--;
-        }
+      return false;
+    };
 
-        // Empty value if nothing at all
-        if (iBeg == IniStr::npos && iEnd == IniStr::npos) {
-          strVal = "";
+    // Parse config line and set key and value in a specific section, if it isn't a section line
+    bool ParseLine(const IniStr &strLine, IniStr &strSection) {
+      const char *pchLine = strLine.c_str();
+      return ParseLine(pchLine, pchLine + strLine.length(), strSection);
+    };
 
-        } else {
-          strVal = strVal.substr(iBeg, iEnd - iBeg + 1);
+    // Read config from a range of characters in a single pass
+    void Read(const char *pchText, const char *pchEnd) {
+      ASSERT(!m_bFrozen);
+
+      // Keys and values are assigned into the same buffers to reuse their memory
+      IniStr strKey, strVal;
+      IniRange rName, rValue;
+
+      // Section that's currently being filled (resolved upon adding the first key)
+      iterator itSection = end();
+      IniStr strSection;
+
+      while (pchText != pchEnd) {
+        // Find the end of the current line
+        const char *pchLineEnd = pchText;
+        while (pchLineEnd != pchEnd && *pchLineEnd != '\n' && *pchLineEnd != '\r') ++pchLineEnd;
+
+        switch (SplitLine(pchText, pchLineEnd, rName, rValue)) {
+          case E_LINE_SECTION:
+            strSection.assign(rName.pchBeg, rName.pchEnd);
+            itSection = end();
+            break;
+
+          case E_LINE_KEY: {
+            // Create new section, if there isn't the one needed
+            if (itSection == end()) {
+              itSection = find(strSection);
+              if (itSection == end()) itSection = insert(value_type(strSection, NewKeys())).first;
+
+              ChangeSection(strSection);
+            }
+
+            strKey.assign(rName.pchBeg, rName.pchEnd);
+            strVal.assign(rValue.pchBeg, rValue.pchEnd);
+
+            // Insert a new key-value pair or update an existing one
+            IniKeys &keys = itSection->second;
+            IniKeys::iterator itPair = keys.find(CIniText(CIniText::E_REFERENCE, strKey));
+
+            if (itPair == keys.end()) {
+              KeepPair(*keys.insert(ReferencePair(strKey, strVal)).first);
+              ChangeStructure();
+            } else {
+              itPair->second = strVal;
+            }
+          } break;
         }
-      }
 
-      SetValue(strSection.c_str(), strKey.c_str(), strVal.c_str());
-      return true;
+        // Skip the line break
+        pchText = pchLineEnd;
+        if (pchText != pchEnd) ++pchText;
+      }
     };
 
     // Read config from a string
     void Read(const IniStr &str) {
-      // Parse each line from the string
-      std::istringstream strm(str);
-      IniStr strLine, strSection;
-
-      while (std::getline(strm, strLine)) {
-        ParseLine(strLine, strSection);
-      }
+      const char *pchText = str.c_str();
+      Read(pchText, pchText + str.length());
     };
 
-    // Load config from a file
-    void Load_t(const CTString &strFile, bool bEngineStreams)
+    // Read entire file into a string
+    static void ReadFile_t(const CTString &strFile, bool bEngineStreams, IniStr &strContents)
     {
       // Use Serious Engine streams (can load from GRO packages)
       if (bEngineStreams) {
         CTFileStream strm;
         strm.Open_t(strFile);
 
-        // Read all text from the file
         const size_t iFileSize = strm.GetStreamSize() - strm.GetPos_t();
-        IniStr strContents(iFileSize, '\0');
+        strContents.resize(iFileSize);
 
         if (iFileSize > 0) {
           strm.Read_t(&strContents[0], iFileSize);
-
-          // Replace carriage returns with other line breaks
-          size_t iReturn = 0;
-          while ((iReturn = strContents.find('\r', iReturn)) != IniStr::npos) {
-            strContents[iReturn] = '\n';
-          }
         }
 
-        // Load data from a string
-        Read(strContents);
-
         strm.Close();
 
       // Use stock loader (can be used before engine initialization)
       } else {
-        std::ifstream strm((IDir::AppPath() + strFile).str_String);
+        FILE *pFile = fopen((IDir::AppPath() + strFile).str_String, "rb");
 
-        if (strm.fail()) {
+        if (pFile == NULL) {
           ThrowF_t((char *)TRANSV("Cannot open file `%s' (%s)"), strFile, strerror(errno));
         }
 
-        // Parse each line from the file
-        IniStr strLine, strSection;
+        fseek(pFile, 0, SEEK_END);
+        const long iFileSize = ftell(pFile);
+        fseek(pFile, 0, SEEK_SET);
+
+        strContents.resize(iFileSize > 0 ? iFileSize : 0);
 
-        while (std::getline(strm, strLine)) {
-          ParseLine(strLine, strSection);
+        if (iFileSize > 0) {
+          strContents.resize(fread(&strContents[0], 1, iFileSize, pFile));
         }
 
-        strm.close();
+        fclose(pFile);
       }
     };
 
-    // Write config into a string
-    void Write(IniStr &str) const {
-      std::ostringstream strm;
-      const_iterator it = begin();
-
-      for (; it != end(); it++) {
-        // Non-empty section
-        if (it->first != "") {
-          strm << '[' << it->first << "]\n";
+    // Write entire file from memory
+    static void WriteFile_t(const CTString &strFile, bool bEngineStreams, const char *pchData, size_t ctData)
+    {
+      // Use Serious Engine streams
+      if (bEngineStreams) {
+        CTFileStream strm;
+        strm.Create_t(strFile);
+
+        if (ctData > 0) {
+          strm.Write_t(pchData, ctData);
+        }
+
+        strm.Close();
+
+      // Use stock writer (can be used before engine initialization)
+      } else {
+        FILE *pFile = fopen((IDir::AppPath() + strFile).str_String, "wb");
+
+        if (pFile == NULL) {
+          ThrowF_t((char *)TRANSV("Cannot create file `%s' (%s)"), strFile, strerror(errno));
+        }
+
+        const size_t ctWritten = (ctData > 0) ? fwrite(pchData, 1, ctData, pFile) : 0;
+        fclose(pFile);
+
+        if (ctWritten != ctData) {
+          ThrowF_t((char *)TRANSV("Cannot write to file `%s'"), strFile);
+        }
+      }
+    };
+
+    // Load config from a file
+    void Load_t(const CTString &strFile, bool bEngineStreams)
+    {
+      // Read the whole file at once and parse it in place
+      IniStr strContents;
+      ReadFile_t(strFile, bEngineStreams, strContents);
+
+      Read(strContents);
+    };
+
+    // Compute hash of config text to check if it has changed
+    static UQUAD HashText(const char *pch, size_t ct) {
+      const UQUAD uqMul = 0x9E3779B97F4A7C15ULL;
+      UQUAD uqHash = ct * uqMul;
+
+      // Mix in eight characters at a time
+      for (; ct >= sizeof(UQUAD); ct -= sizeof(UQUAD), pch += sizeof(UQUAD)) {
+        UQUAD uqWord;
+        memcpy(&uqWord, pch, sizeof(UQUAD));
+
+        uqHash = (uqHash ^ uqWord) * uqMul;
+        uqHash ^= uqHash >> 29;
+      }
+
+      // Mix in the remaining characters
+      for (; ct != 0; --ct, ++pch) {
+        uqHash = (uqHash ^ (UBYTE)*pch) * uqMul;
+      }
+
+      return uqHash ^ (uqHash >> 32);
+    };
+
+    // Make this config identical to another one by only changing what's different
+    // Existing keys stay in place, so only the changed values need to be read again; new keys are added at the end of sections
+    // Returns amount of changed keys and reports each one of them, if there's a callback
+    ULONG Update(const CIniConfig &iniNew, FIniChangeCallback pCallback = NULL, void *pUserData = NULL) {
+      ULONG ctChanges = 0;
+
+      // Remove keys and sections that don't exist anymore
+      iterator it = begin();
+
+      while (it != end()) {
+        const_iterator itNewSection = iniNew.find(it->first);
+        IniKeys &keys = it->second;
+
+        IniKeys::iterator itPair = keys.begin();
+
+        while (itPair != keys.end()) {
+          // Key still exists
+          if (itNewSection != iniNew.end() && itNewSection->second.find(itPair->first) != itNewSection->second.end()) {
+            itPair++;
+            continue;
+          }
+
+          ctChanges++;
+          ChangeStructure();
+          ChangeSection(it->first);
+
+          // Report the removal after the key is gone
+          if (pCallback != NULL) {
+            const CIniText strKey = itPair->first;
+            const CIniText strOld = itPair->second.GetText();
+            itPair = keys.erase(itPair);
+
+            pCallback(E_INI_REMOVED, it->first, strKey, strOld, CIniText(), pUserData);
+
+          } else {
+            itPair = keys.erase(itPair);
+          }
         }
 
-        const IniKeys &pairs = it->second;
-        IniKeys::const_iterator itPair = pairs.begin();
+        // Remove the section if it doesn't exist anymore
+        if (itNewSection == iniNew.end()) {
+          RemoveSection(it->first);
+          it = erase(it);
+          ChangeStructure();
+        } else {
+          it++;
+        }
+      }
+
+      // Add new keys and change values of existing ones
+      const_iterator itNew = iniNew.begin();
+
+      for (; itNew != iniNew.end(); itNew++) {
+        iterator itSection = find(itNew->first);
+
+        if (itSection == end()) {
+          itSection = insert(value_type(itNew->first, NewKeys())).first;
+          ChangeStructure();
+          ChangeSection(itNew->first);
+        }
 
-        // key = "value"
-        for (; itPair != pairs.end(); itPair++) {
-          const IniStr &str = itPair->second;
+        IniKeys &keys = itSection->second;
+        IniKeys::const_iterator itNewPair = itNew->second.begin();
 
-          // Find spaces on either end
-          size_t iBegSpace = str.find_first_of(" \t");
-          size_t iEndSpace = str.find_last_of(" \t");
+        for (; itNewPair != itNew->second.end(); itNewPair++) {
+          IniKeys::_Pairib ib = keys.insert(ReferencePair(itNewPair->first, itNewPair->second.GetText()));
+
+          // Added a new key
+          if (ib.second) {
+            KeepPair(*ib.first);
+            ctChanges++;
+            ChangeStructure();
+            ChangeSection(itNew->first);
+
+            if (pCallback != NULL) {
+              pCallback(E_INI_ADDED, itNew->first, itNewPair->first, CIniText(), itNewPair->second.GetText(), pUserData);
+            }
+
+            continue;
+          }
+
+          // Same value
+          CIniValue &val = ib.first->second;
+          if (val == itNewPair->second) continue;
+
+          ctChanges++;
+          ChangeSection(itNew->first);
+
+          // Report the change after setting the new value
+          if (pCallback != NULL) {
+            const CIniText strOld = val.GetText();
+            val = itNewPair->second;
+
+            pCallback(E_INI_CHANGED, itNew->first, itNewPair->first, strOld, val.GetText(), pUserData);
 
-          // Surround with quotes if there's a space on either end
-          if (iBegSpace == 0 || iEndSpace == str.length() - 1) {
-            strm << itPair->first << " = \"" << str << "\"\n";
           } else {
-            strm << itPair->first << " = " << str << '\n';
+            val = itNewPair->second;
           }
         }
       }
 
-      str = strm.str();
+      return ctChanges;
+    };
+
+  // Text output
+  private:
+
+    // Check if a value needs to be surrounded with quotes to keep spaces on either end
+    static __forceinline bool NeedsQuotes(const CIniText &str) {
+      return str.empty() || IsSpace(str[0]) || IsSpace(str[str.length() - 1]);
+    };
+
+    // Count characters in the text of a section
+    static size_t MeasureSection(const IniStr &strSection, const IniKeys &pairs, bool bCRLF) {
+      const size_t ctBreak = bCRLF ? 2 : 1;
+
+      // [section]
+      size_t ct = (strSection != "") ? strSection.length() + 2 + ctBreak : 0;
+
+      // key = "value"
+      IniKeys::const_iterator itPair = pairs.begin();
+
+      for (; itPair != pairs.end(); itPair++) {
+        ct += itPair->first.length() + itPair->second.length() + 3 + ctBreak;
+        if (NeedsQuotes(itPair->second.GetText())) ct += 2;
+      }
+
+      return ct;
+    };
+
+    // Copy a string into the text and return the position after it
+    static __forceinline char *PutString(char *pch, const char *str, size_t ct) {
+      memcpy(pch, str, ct);
+      return pch + ct;
+    };
+
+    static __forceinline char *PutString(char *pch, const IniStr &str) {
+      return PutString(pch, str.c_str(), str.length());
+    };
+
+    static __forceinline char *PutString(char *pch, const CIniText &str) {
+      return PutString(pch, str.c_str(), str.length());
+    };
+
+    // End the line and return the position after it
+    static __forceinline char *PutLineBreak(char *pch, bool bCRLF) {
+      if (bCRLF) *pch++ = '\r';
+      *pch++ = '\n';
+      return pch;
+    };
+
+    // Print text of a section into a buffer that fits it and return the position after it
+    static char *PrintSection(char *pch, const IniStr &strSection, const IniKeys &pairs, bool bCRLF) {
+      // Non-empty section
+      if (strSection != "") {
+        *pch++ = '[';
+        pch = PutString(pch, strSection);
+        *pch++ = ']';
+        pch = PutLineBreak(pch, bCRLF);
+      }
+
+      IniKeys::const_iterator itPair = pairs.begin();
+
+      for (; itPair != pairs.end(); itPair++) {
+        pch = PutString(pch, itPair->first);
+        *pch++ = ' ';
+        *pch++ = '=';
+        *pch++ = ' ';
+
+        // Surround with quotes if there's a space on either end
+        if (NeedsQuotes(itPair->second.GetText())) {
+          *pch++ = '\"';
+          pch = PutString(pch, itPair->second.GetText());
+          *pch++ = '\"';
+
+        } else {
+          pch = PutString(pch, itPair->second.GetText());
+        }
+
+        pch = PutLineBreak(pch, bCRLF);
+      }
+
+      return pch;
+    };
+
+  public:
+    // Write config into a string
+    // Saved files use CRLF line breaks, like engine streams write them with PutString_t().
+    void Write(IniStr &str, bool bCRLF = false) const {
+      // Measure the text to fill it in one go
+      size_t ctText = 0;
+      const_iterator it;
+
+      for (it = begin(); it != end(); it++) {
+        ctText += MeasureSection(it->first, it->second, bCRLF);
+      }
+
+      str.resize(ctText);
+      if (ctText == 0) return;
+
+      char *pch = &str[0];
+
+      for (it = begin(); it != end(); it++) {
+        pch = PrintSection(pch, it->first, it->second, bCRLF);
+      }
+
+      ASSERT(pch == str.c_str() + ctText);
     };
 
     // Save config into a file
     void Save_t(const CTString &strFile) const {
-      CTFileStream strm;
-      strm.Create_t(strFile);
-
       IniStr strSave;
-      Write(strSave);
-      strm.PutString_t(strSave.c_str());
+      Write(strSave, true);
+
+      WriteFile_t(strFile, true, strSave.c_str(), strSave.length());
+    };
+
+    // Save config into a file by only printing sections that have changed since the last time this function was called
+    // Returns false without writing anything if nothing has changed since the last save into the same file
+    // NOTE: It remembers what has been saved, so it cannot be used on frozen configs that may be read from other threads!
+    bool SaveChanges_t(const CTString &strFile, bool bEngineStreams = true) {
+      ASSERT(!m_bFrozen);
+      if (!m_bUnsaved && m_strSavedFile == strFile) return false;
+
+      // Reuse memory of the previous save
+      m_strSaveBuffer.clear();
+
+      for (const_iterator it = begin(); it != end(); it++) {
+        SavedSection &saved = m_mapSaved[it->first];
+
+        // Print the section again
+        if (saved.bDirty) {
+          saved.strText.resize(MeasureSection(it->first, it->second, true));
+
+          if (!saved.strText.empty()) {
+            PrintSection(&saved.strText[0], it->first, it->second, true);
+          }
+
+          saved.bDirty = false;
+        }
+
+        m_strSaveBuffer.append(saved.strText);
+      }
+
+      WriteFile_t(strFile, bEngineStreams, m_strSaveBuffer.c_str(), m_strSaveBuffer.length());
+
+      m_strSavedFile = strFile;
+      m_bUnsaved = false;
+      return true;
+    };
+};
+
+// Pre-resolved reference to a key under some section of a specific config
+// Resolves the key only once and then reads its value directly until keys or sections are added or removed
+// NOTE: The config must outlive all handles that reference it!
+class CIniKeyHandle {
+  private:
+    const CIniConfig *m_pConfig; // Config that the key belongs to
+    IniStr m_strSection;
+    IniStr m_strKey;
+
+    mutable const CIniValue *m_pValue; // Cached value of the key (NULL if it doesn't exist)
+    mutable ULONG m_ulGeneration; // Config generation at the time of caching the value
+
+  public:
+    // Default constructor
+    CIniKeyHandle() : m_pConfig(NULL), m_pValue(NULL), m_ulGeneration(0) {};
+
+    // Constructor with a specific key
+    CIniKeyHandle(const CIniConfig &ini, const char *strSection, const char *strKey) {
+      Resolve(ini, strSection, strKey);
+    };
+
+    // Reference a key under some section of a specific config
+    void Resolve(const CIniConfig &ini, const char *strSection, const char *strKey) {
+      m_pConfig = &ini;
+      m_strSection = strSection;
+      m_strKey = strKey;
+
+      Update();
+    };
+
+    // Check if the handle references any config
+    inline bool IsResolved(void) const {
+      return m_pConfig != NULL;
+    };
+
+    // Check if the key currently exists
+    inline bool Exists(void) const {
+      return Value() != NULL;
+    };
+
+  private:
+    // Find the key again in the config
+    void Update(void) const {
+      m_pValue = m_pConfig->FindValue(m_strSection, m_strKey);
+      m_ulGeneration = m_pConfig->m_ulGeneration;
+    };
+
+    // Get current value of the key (or NULL if it has been removed)
+    __forceinline const CIniValue *Value(void) const {
+      if (m_pConfig == NULL) return NULL;
+
+      // Keys have been added or removed since the last time
+      if (m_ulGeneration != m_pConfig->m_ulGeneration) Update();
+
+      return m_pValue;
+    };
+
+  public:
+    // Get value of the key or return a default value, if it doesn't exist
+    CTString GetValue(const char *strDefValue = "") const {
+      const CIniValue *pval = Value();
+      return (pval != NULL) ? pval->c_str() : strDefValue;
+    };
+
+    // Get boolean value of the key or return a default value, if it doesn't exist
+    bool GetBoolValue(bool bDefValue) const {
+      const CIniValue *pval = Value();
+      return (pval != NULL) ? pval->GetBool(bDefValue, m_pConfig->ReadStats()) : bDefValue;
+    };
+
+    // Get integer value of the key or return a default value, if it doesn't exist
+    SLONG GetIntValue(SLONG iDefValue) const {
+      const CIniValue *pval = Value();
+      return (pval != NULL) ? pval->GetInt(iDefValue, m_pConfig->ReadStats()) : iDefValue;
+    };
 
-      strm.Close();
+    // Get float value of the key or return a default value, if it doesn't exist
+    DOUBLE GetDoubleValue(DOUBLE dDefValue) const {
+      const CIniValue *pval = Value();
+      return (pval != NULL) ? pval->GetDouble(dDefValue, m_pConfig->ReadStats()) : dDefValue;
     };
 };
 
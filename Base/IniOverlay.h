@@ -0,0 +1,264 @@
+/* Copyright (c) 2026 Dreamy Cecil
+This program is free software; you can redistribute it and/or modify
+it under the terms of version 2 of the GNU General Public License as published by
+the Free Software Foundation
+
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License along
+with this program; if not, write to the Free Software Foundation, Inc.,
+51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA. */
+
+#ifndef XGIZMO_INCL_INIOVERLAY_H
+#define XGIZMO_INCL_INIOVERLAY_H
+
+#ifdef PRAGMA_ONCE
+  #pragma once
+#endif
+
+#include "IniConfig.h"
+
+#include "../Base/STLIncludesBegin.h"
+#include <vector>
+#include "../Base/STLIncludesEnd.h"
+
+// Value of a key in the topmost layer that has it
+struct IniResolved {
+  const CIniValue *pValue;
+  INDEX iLayer;
+
+  IniResolved() : pValue(NULL), iLayer(-1) {};
+};
+
+typedef se1::map<CIniText, IniResolved> IniResolvedKeys;
+
+// Section names are kept as config text, so they can be looked up without copying them
+typedef se1::map<CIniText, IniResolvedKeys> IniResolvedSections;
+
+// Stack of configs where keys of each layer override the same keys in layers below it (e.g. defaults, then mods, then user)
+// All keys are gathered into one view, so a lookup is the same as in a single config regardless of the amount of layers.
+// The view is updated before each lookup by only going through keys of layers whose structure has changed since the last time.
+// NOTE: Layers are referenced directly, so they must exist for as long as they are in the overlay!
+class CIniOverlay {
+  private:
+    // Key in the view
+    struct ViewKey {
+      IniResolvedSections::iterator itSection;
+      IniResolvedKeys::iterator itKey;
+    };
+
+    // One config in the stack
+    struct Layer {
+      const CIniConfig *pConfig;
+      mutable ULONG ulGeneration; // Config generation at the time of resolving its keys
+      mutable bool bResolved; // Keys have been put into the view
+      mutable std::vector<ViewKey> aKeys; // Keys in the view that the config had at the time of resolving them
+    };
+
+    std::vector<Layer> m_aLayers; // From the bottom to the top
+    mutable IniResolvedSections m_mapView; // Flattened keys of all layers
+
+  public:
+    // Add a new layer on top of all others
+    void AddLayer(const CIniConfig &ini) {
+      Layer layer;
+      layer.pConfig = &ini;
+      layer.ulGeneration = 0;
+      layer.bResolved = false;
+
+      m_aLayers.push_back(layer);
+    };
+
+    // Remove all layers
+    void ClearLayers(void) {
+      m_aLayers.clear();
+      m_mapView.clear();
+    };
+
+    // Count layers in the stack
+    inline INDEX CountLayers(void) const {
+      return (INDEX)m_aLayers.size();
+    };
+
+    // Get config of some layer
+    inline const CIniConfig &GetLayer(INDEX iLayer) const {
+      return *m_aLayers[iLayer].pConfig;
+    };
+
+  private:
+    // Find a key in the topmost layer below a specific one
+    bool FindBelow(INDEX iLayer, const IniStr &strSection, const CIniText &strKey, IniResolved &res) const {
+      while (--iLayer >= 0) {
+        const CIniValue *pval = m_aLayers[iLayer].pConfig->FindValue(strSection, strKey);
+
+        if (pval != NULL) {
+          res.pValue = pval;
+          res.iLayer = iLayer;
+          return true;
+        }
+      }
+
+      return false;
+    };
+
+    // Put keys of a specific layer into the view
+    // Only keys that the layer has now or had the last time are visited, so it doesn't depend on the size of other layers.
+    // Layers must be resolved from the bottom, which guarantees that keys in the view that are taken from a layer
+    // aren't referenced by any layers above it and a key that no layer has is only referenced by the layer that removes it.
+    void ResolveLayer(INDEX iLayer) const {
+      const Layer &layer = m_aLayers[iLayer];
+
+      // Keys that have been taken from this layer may not exist in it anymore, so take them from layers below or remove them
+      if (layer.bResolved) {
+        const INDEX ctKeys = (INDEX)layer.aKeys.size();
+
+        for (INDEX iKey = 0; iKey < ctKeys; iKey++) {
+          const ViewKey &key = layer.aKeys[iKey];
+          IniResolved &res = key.itKey->second;
+
+          // Overridden by a layer above or still here, in which case it's updated below
+          if (res.iLayer != iLayer) continue;
+
+          const IniStr strSection = key.itSection->first.ToStr();
+          if (layer.pConfig->FindValue(strSection, key.itKey->first) != NULL) continue;
+
+          if (!FindBelow(iLayer, strSection, key.itKey->first, res)) {
+            key.itSection->second.erase(key.itKey);
+            if (key.itSection->second.empty()) m_mapView.erase(key.itSection);
+          }
+        }
+      }
+
+      layer.aKeys.clear();
+
+      // Override keys from layers below it
+      const IniSections &sections = layer.pConfig->GetMap();
+      IniSections::const_iterator it;
+
+      for (it = sections.begin(); it != sections.end(); it++) {
+        if (it->second.empty()) continue;
+
+        ViewKey key;
+        key.itSection = m_mapView.find(CIniText(CIniText::E_REFERENCE, it->first));
+
+        if (key.itSection == m_mapView.end()) {
+          key.itSection = m_mapView.insert(IniResolvedSections::value_type(CIniText(it->first), IniResolvedKeys())).first;
+        }
+
+        IniResolvedKeys &keys = key.itSection->second;
+        IniKeys::const_iterator itPair = it->second.begin();
+
+        for (; itPair != it->second.end(); itPair++) {
+          key.itKey = keys.find(itPair->first);
+          if (key.itKey == keys.end()) key.itKey = keys.insert(IniResolvedKeys::value_type(itPair->first, IniResolved())).first;
+
+          IniResolved &res = key.itKey->second;
+
+          if (res.iLayer <= iLayer) {
+            res.pValue = &itPair->second;
+            res.iLayer = iLayer;
+          }
+
+          layer.aKeys.push_back(key);
+        }
+      }
+
+      layer.ulGeneration = layer.pConfig->GetGeneration();
+      layer.bResolved = true;
+    };
+
+  public:
+    // Update the view with layers whose keys have been added or removed since the last time
+    // Layers are resolved from the bottom, so values from the changed layers below are in place before going through the ones above
+    void Refresh(void) const {
+      const INDEX ctLayers = CountLayers();
+
+      for (INDEX iLayer = 0; iLayer < ctLayers; iLayer++) {
+        const Layer &layer = m_aLayers[iLayer];
+
+        if (!layer.bResolved || layer.ulGeneration != layer.pConfig->GetGeneration()) {
+          ResolveLayer(iLayer);
+        }
+      }
+    };
+
+    // Get flattened view of all layers
+    const IniResolvedSections &GetView(void) const {
+      Refresh();
+      return m_mapView;
+    };
+
+    // Find value of a key under some section in the topmost layer that has it (returns NULL if no layer has it)
+    const CIniValue *FindValue(const CIniText &strSection, const CIniText &strKey, INDEX *piLayer = NULL) const {
+      Refresh();
+
+      IniResolvedSections::const_iterator it = m_mapView.find(strSection);
+
+      if (it != m_mapView.end()) {
+        IniResolvedKeys::const_iterator itKey = it->second.find(strKey);
+
+        if (itKey != it->second.end()) {
+          if (piLayer != NULL) *piLayer = itKey->second.iLayer;
+          return itKey->second.pValue;
+        }
+      }
+
+      if (piLayer != NULL) *piLayer = -1;
+      return NULL;
+    };
+
+    // Find value of a key under some section in the topmost layer that has it (returns NULL if no layer has it)
+    inline const CIniValue *FindValue(const IniStr &strSection, const IniStr &strKey, INDEX *piLayer = NULL) const {
+      return FindValue(CIniText(CIniText::E_REFERENCE, strSection), CIniText(CIniText::E_REFERENCE, strKey), piLayer);
+    };
+
+    // Find value of a key under some section in the topmost layer that has it without copying any text
+    inline const CIniValue *FindValue(const char *strSection, const char *strKey, INDEX *piLayer = NULL) const {
+      return FindValue(CIniText(CIniText::E_REFERENCE, strSection), CIniText(CIniText::E_REFERENCE, strKey), piLayer);
+    };
+
+    // Get layer that a key is taken from (returns -1 if no layer has it)
+    INDEX GetLayerOf(const char *strSection, const char *strKey) const {
+      INDEX iLayer;
+      FindValue(strSection, strKey, &iLayer);
+      return iLayer;
+    };
+
+    // Check if some key exists in any layer
+    inline bool KeyExists(const char *strSection, const char *strKey) const {
+      return FindValue(strSection, strKey) != NULL;
+    };
+
+    // Get value under a key or return a default value, if no layer has it
+    CTString GetValue(const char *strSection, const char *strKey, const char *strDefValue = "") const {
+      const CIniValue *pval = FindValue(strSection, strKey);
+      return (pval != NULL) ? pval->c_str() : strDefValue;
+    };
+
+    // Get boolean value under a key or return a default value, if no layer has it
+    bool GetBoolValue(const char *strSection, const char *strKey, bool bDefValue) const {
+      INDEX iLayer;
+      const CIniValue *pval = FindValue(strSection, strKey, &iLayer);
+      return (pval != NULL) ? pval->GetBool(bDefValue, GetLayer(iLayer).ReadStats()) : bDefValue;
+    };
+
+    // Get integer value under a key or return a default value, if no layer has it
+    SLONG GetIntValue(const char *strSection, const char *strKey, SLONG iDefValue) const {
+      INDEX iLayer;
+      const CIniValue *pval = FindValue(strSection, strKey, &iLayer);
+      return (pval != NULL) ? pval->GetInt(iDefValue, GetLayer(iLayer).ReadStats()) : iDefValue;
+    };
+
+    // Get float value under a key or return a default value, if no layer has it
+    DOUBLE GetDoubleValue(const char *strSection, const char *strKey, DOUBLE dDefValue) const {
+      INDEX iLayer;
+      const CIniValue *pval = FindValue(strSection, strKey, &iLayer);
+      return (pval != NULL) ? pval->GetDouble(dDefValue, GetLayer(iLayer).ReadStats()) : dDefValue;
+    };
+};
+
+#endif
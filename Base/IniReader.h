@@ -0,0 +1,232 @@
+/* Copyright (c) 2026 Dreamy Cecil
+This program is free software; you can redistribute it and/or modify
+it under the terms of version 2 of the GNU General Public License as published by
+the Free Software Foundation
+
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License along
+with this program; if not, write to the Free Software Foundation, Inc.,
+51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA. */
+
+#ifndef XGIZMO_INCL_INIREADER_H
+#define XGIZMO_INCL_INIREADER_H
+
+#ifdef PRAGMA_ONCE
+  #pragma once
+#endif
+
+#include "IniConfig.h"
+
+#include "../Base/STLIncludesBegin.h"
+#include <vector>
+#include "../Base/STLIncludesEnd.h"
+
+// Receiver of config lines from the streaming reader
+// Ranges only stay valid until the function returns, so anything that's needed afterwards has to be copied
+class CIniHandler {
+  public:
+    virtual ~CIniHandler() {};
+
+    // Beginning of a new section (return false to stop reading)
+    virtual bool OnSection(const IniRange &) { return true; };
+
+    // Key and its value under the current section (return false to stop reading)
+    virtual bool OnKey(const IniRange &rSection, const IniRange &rKey, const IniRange &rValue) = 0;
+
+    // End of the config (only called if reading hasn't been stopped)
+    virtual void OnEnd(void) {};
+};
+
+// Streaming config reader that reports each line to a handler instead of building a config
+// Text is read in chunks of a fixed size, so memory usage only depends on the longest line instead of the size of the config
+// Lines that don't fit into one chunk are read whole by making the buffer bigger.
+class CIniReader {
+  private:
+    // Source of text from an engine stream
+    struct StreamSource {
+      CTStream &strm;
+      size_t ctLeft;
+
+      StreamSource(CTStream &strmSet) : strm(strmSet) {
+        ctLeft = strm.GetStreamSize() - strm.GetPos_t();
+      };
+
+      size_t Read_t(char *pchBuffer, size_t ctMax) {
+        const size_t ct = (ctLeft < ctMax) ? ctLeft : ctMax;
+
+        if (ct > 0) {
+          strm.Read_t(pchBuffer, ct);
+          ctLeft -= ct;
+        }
+
+        return ct;
+      };
+    };
+
+    // Source of text from a stock file
+    struct FileSource {
+      FILE *pFile;
+
+      size_t Read_t(char *pchBuffer, size_t ctMax) {
+        return fread(pchBuffer, 1, ctMax, pFile);
+      };
+    };
+
+    CIniHandler &m_handler;
+    IniStr m_strSection; // Name of the current section
+    bool m_bStopped; // Handler has stopped the reading
+
+  public:
+    // Constructor with a handler of lines
+    CIniReader(CIniHandler &handler) : m_handler(handler), m_bStopped(false)
+    {
+    };
+
+    // Check if the handler has stopped the reading
+    inline bool IsStopped(void) const { return m_bStopped; };
+
+  private:
+    // Start reading from the beginning of a config
+    void Begin(void) {
+      m_strSection = "";
+      m_bStopped = false;
+    };
+
+    // Report one line to the handler
+    void ParseLine(const char *pchLine, const char *pchEnd) {
+      IniRange rName, rValue;
+
+      switch (CIniConfig::SplitLine(pchLine, pchEnd, rName, rValue)) {
+        case CIniConfig::E_LINE_SECTION: {
+          m_strSection.assign(rName.pchBeg, rName.pchEnd);
+
+          IniRange rSection;
+          rSection.pchBeg = m_strSection.c_str();
+          rSection.pchEnd = rSection.pchBeg + m_strSection.length();
+
+          if (!m_handler.OnSection(rSection)) m_bStopped = true;
+        } break;
+
+        case CIniConfig::E_LINE_KEY: {
+          IniRange rSection;
+          rSection.pchBeg = m_strSection.c_str();
+          rSection.pchEnd = rSection.pchBeg + m_strSection.length();
+
+          if (!m_handler.OnKey(rSection, rName, rValue)) m_bStopped = true;
+        } break;
+      }
+    };
+
+    // Report all complete lines in a range and return the beginning of the incomplete last line
+    const char *ParseLines(const char *pchText, const char *pchEnd) {
+      while (!m_bStopped) {
+        const char *pchLineEnd = pchText;
+        while (pchLineEnd != pchEnd && *pchLineEnd != '\n' && *pchLineEnd != '\r') ++pchLineEnd;
+
+        if (pchLineEnd == pchEnd) break;
+
+        ParseLine(pchText, pchLineEnd);
+        pchText = pchLineEnd + 1;
+      }
+
+      return pchText;
+    };
+
+    // Read text from some source chunk by chunk
+    template<class Source>
+    void ParseSource_t(Source &src, size_t ctChunk) {
+      ASSERT(ctChunk > 0);
+      Begin();
+
+      std::vector<char> aBuffer(ctChunk);
+      size_t ctFilled = 0;
+
+      while (!m_bStopped) {
+        char *pchBuffer = &aBuffer[0];
+        const size_t ctRead = src.Read_t(pchBuffer + ctFilled, aBuffer.size() - ctFilled);
+        const char *pchEnd = pchBuffer + ctFilled + ctRead;
+        const char *pchText = ParseLines(pchBuffer, pchEnd);
+
+        // Parse the last line without a line break
+        if (ctRead == 0) {
+          if (!m_bStopped && pchText != pchEnd) ParseLine(pchText, pchEnd);
+          break;
+        }
+
+        ctFilled = pchEnd - pchText;
+
+        // The line doesn't fit into the buffer, so make it bigger to read the rest of it
+        if (ctFilled == aBuffer.size()) {
+          aBuffer.resize(aBuffer.size() * 2);
+
+        // Move the incomplete line to the beginning
+        } else if (ctFilled != 0) {
+          memmove(pchBuffer, pchText, ctFilled);
+        }
+      }
+
+      if (!m_bStopped) m_handler.OnEnd();
+    };
+
+  public:
+    // Read config from a range of characters (returns false if the handler has stopped the reading)
+    bool Parse(const char *pchText, const char *pchEnd) {
+      Begin();
+      pchText = ParseLines(pchText, pchEnd);
+
+      if (!m_bStopped) {
+        if (pchText != pchEnd) ParseLine(pchText, pchEnd);
+        if (!m_bStopped) m_handler.OnEnd();
+      }
+
+      return !m_bStopped;
+    };
+
+    // Read config from the current position until the end of a stream (returns false if the handler has stopped the reading)
+    bool Parse_t(CTStream &strm, size_t ctChunk = 4096) {
+      StreamSource src(strm);
+      ParseSource_t(src, ctChunk);
+      return !m_bStopped;
+    };
+
+    // Read config from a file (returns false if the handler has stopped the reading)
+    bool ParseFile_t(const CTString &strFile, bool bEngineStreams, size_t ctChunk = 4096) {
+      // Use Serious Engine streams (can load from GRO packages)
+      if (bEngineStreams) {
+        CTFileStream strm;
+        strm.Open_t(strFile);
+
+        Parse_t(strm, ctChunk);
+        strm.Close();
+
+        return !m_bStopped;
+      }
+
+      // Use stock loader (can be used before engine initialization)
+      FileSource src;
+      src.pFile = fopen((IDir::AppPath() + strFile).str_String, "rb");
+
+      if (src.pFile == NULL) {
+        ThrowF_t((char *)TRANSV("Cannot open file `%s' (%s)"), strFile, strerror(errno));
+      }
+
+      try {
+        ParseSource_t(src, ctChunk);
+
+      } catch (char *) {
+        fclose(src.pFile);
+        throw;
+      }
+
+      fclose(src.pFile);
+
+      return !m_bStopped;
+    };
+};
+
+#endif
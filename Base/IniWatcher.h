@@ -0,0 +1,141 @@
+/* Copyright (c) 2026 Dreamy Cecil
+This program is free software; you can redistribute it and/or modify
+it under the terms of version 2 of the GNU General Public License as published by
+the Free Software Foundation
+
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License along
+with this program; if not, write to the Free Software Foundation, Inc.,
+51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA. */
+
+#ifndef XGIZMO_INCL_INIWATCHER_H
+#define XGIZMO_INCL_INIWATCHER_H
+
+#ifdef PRAGMA_ONCE
+  #pragma once
+#endif
+
+#include "IniConfig.h"
+
+#include <sys/types.h>
+#include <sys/stat.h>
+#include <time.h>
+
+// Watcher of a config file that applies its changes to a config instead of loading it from scratch
+// Checks modification time and size of the file and compares its text with the last one if either of them change.
+// Modification time may only be precise to a second or two, so the text is also compared on every check for a few seconds
+// after the file has been modified, in case it's been modified again without changing its size.
+// NOTE: Only files on disk can be watched, so configs inside GRO packages never report any changes!
+class CIniFileWatcher {
+  private:
+    CTString m_strFile; // Watched file relative to the game directory
+    CTString m_strFullPath; // Absolute path to the watched file
+    bool m_bEngineStreams; // Read the file using Serious Engine streams
+
+    // Last known state of the file
+    time_t m_tmModified;
+    off_t m_iSize;
+    UQUAD m_uqHash; // Hash of the last read text
+
+    // Cannot be copied
+    CIniFileWatcher(const CIniFileWatcher &);
+    void operator=(const CIniFileWatcher &);
+
+  public:
+    // Seconds after the last modification during which the text is compared on every check
+    enum { E_RECENT_CHANGE = 2 };
+
+  public:
+    // Default constructor
+    CIniFileWatcher() : m_bEngineStreams(false), m_tmModified(0), m_iSize(0), m_uqHash(0)
+    {
+    };
+
+    // Stop watching on destruction
+    ~CIniFileWatcher() {
+      Stop();
+    };
+
+    // Check if some file is being watched
+    inline bool IsWatching(void) const {
+      return m_strFile != "";
+    };
+
+    // Start watching a config file in its current state
+    void Watch(const CTString &strFile, bool bEngineStreams) {
+      Stop();
+
+      m_strFile = strFile;
+      m_strFullPath = IDir::AppPath() + strFile;
+      m_bEngineStreams = bEngineStreams;
+
+      // Remember the current state
+      UpdateStats();
+
+      try {
+        IniStr strContents;
+        CIniConfig::ReadFile_t(m_strFile, m_bEngineStreams, strContents);
+        m_uqHash = CIniConfig::HashText(strContents.c_str(), strContents.length());
+
+      } catch (char *) {
+        m_uqHash = 0;
+      }
+    };
+
+    // Stop watching the file
+    void Stop(void) {
+      m_strFile = "";
+    };
+
+  private:
+    // Remember modification time and size of the file (returns false if they are the same)
+    bool UpdateStats(void) {
+      struct stat st;
+      if (stat(m_strFullPath.str_String, &st) != 0) return false;
+
+      if (st.st_mtime == m_tmModified && st.st_size == m_iSize) return false;
+
+      m_tmModified = st.st_mtime;
+      m_iSize = st.st_size;
+      return true;
+    };
+
+  public:
+    // Check if the file may have been modified since the last check
+    bool CheckFile(void) {
+      if (!IsWatching()) return false;
+      if (UpdateStats()) return true;
+
+      // Modification time is the same but the file may have been modified again within the same second
+      const time_t tmNow = time(NULL);
+      return tmNow >= m_tmModified && tmNow - m_tmModified <= E_RECENT_CHANGE;
+    };
+
+    // Apply changes to a config if the file has been modified since the last time
+    // Returns amount of changed keys and reports each one of them, if there's a callback
+    ULONG Poll_t(CIniConfig &ini, FIniChangeCallback pCallback = NULL, void *pUserData = NULL) {
+      if (!CheckFile()) return 0;
+
+      // Read the file and make sure the text itself is different
+      IniStr strContents;
+      CIniConfig::ReadFile_t(m_strFile, m_bEngineStreams, strContents);
+
+      const UQUAD uqHash = CIniConfig::HashText(strContents.c_str(), strContents.length());
+      if (uqHash == m_uqHash) return 0;
+
+      m_uqHash = uqHash;
+
+      // Parse the new state of the config and apply the differences
+      CIniConfig iniNew;
+      iniNew.Read(strContents);
+
+      return ini.Update(iniNew, pCallback, pUserData);
+    };
+};
+
+#endif
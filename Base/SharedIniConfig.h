@@ -0,0 +1,207 @@
+/* Copyright (c) 2026 Dreamy Cecil
+This program is free software; you can redistribute it and/or modify
+it under the terms of version 2 of the GNU General Public License as published by
+the Free Software Foundation
+
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License along
+with this program; if not, write to the Free Software Foundation, Inc.,
+51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA. */
+
+#ifndef XGIZMO_INCL_SHAREDINICONFIG_H
+#define XGIZMO_INCL_SHAREDINICONFIG_H
+
+#ifdef PRAGMA_ONCE
+  #pragma once
+#endif
+
+#include <Engine/Base/Synchronization.h>
+
+#include "IniConfig.h"
+
+#include "../Base/STLIncludesBegin.h"
+#include <vector>
+#include "../Base/STLIncludesEnd.h"
+
+// Config that can be reloaded on one thread while being read on others
+// Readers access frozen snapshots of the config without any locks and writers publish new snapshots in place of old ones.
+// Snapshots are frozen upon publishing, so reading them never writes anything (see CIniConfig::Freeze()).
+// Replaced snapshots are deleted only after every reader has reported being quiescent (e.g. at the end of each frame),
+// which means that readers must not keep references to a snapshot after calling Quiesce()
+// Snapshots can only be saved through the writer interface, so that nothing about saving is remembered in them.
+class CSharedIniConfig {
+  private:
+    // Snapshot that has been replaced by a newer one
+    struct RetiredConfig {
+      CIniConfig *pConfig;
+      LONG iEpoch; // Epoch that every reader has to reach before it can be deleted
+    };
+
+    CIniConfig *volatile m_pCurrent; // Currently published snapshot
+    volatile LONG m_iEpoch; // Incremented with each published snapshot
+
+    volatile LONG *m_aiReaderEpochs; // Last epoch that each reader has been quiescent in
+    INDEX m_ctReaders;
+
+    CTCriticalSection m_csWriters; // Synchronization between writers
+    std::vector<RetiredConfig> m_aRetired; // Snapshots waiting to be deleted
+
+    LONG m_iSavedEpoch; // Epoch of the last saved snapshot
+    CTString m_strSavedFile; // File of the last saved snapshot
+
+    // Cannot be copied
+    CSharedIniConfig(const CSharedIniConfig &);
+    void operator=(const CSharedIniConfig &);
+
+  private:
+    // Read a shared variable with acquire semantics, so everything written before publishing it is visible
+    template<class Type> static __forceinline
+    Type LoadAcquire(const volatile Type &val) {
+    #ifdef _MSC_VER
+      // Volatile reads already have acquire semantics
+      return val;
+    #else
+      return __atomic_load_n(&val, __ATOMIC_ACQUIRE);
+    #endif
+    };
+
+  public:
+    // Constructor with a fixed amount of reader threads
+    CSharedIniConfig(INDEX ctReaders = 1) : m_pCurrent(new CIniConfig), m_iEpoch(0), m_ctReaders(ctReaders), m_iSavedEpoch(-1)
+    {
+      ASSERT(m_ctReaders > 0);
+      m_pCurrent->Freeze();
+
+      m_aiReaderEpochs = new LONG[m_ctReaders];
+
+      for (INDEX iReader = 0; iReader < m_ctReaders; iReader++) {
+        m_aiReaderEpochs[iReader] = 0;
+      }
+    };
+
+    // Delete all snapshots (there should be no readers at this point)
+    ~CSharedIniConfig() {
+      for (size_t iRetired = 0; iRetired < m_aRetired.size(); iRetired++) {
+        delete m_aRetired[iRetired].pConfig;
+      }
+
+      delete m_pCurrent;
+      delete[] m_aiReaderEpochs;
+    };
+
+  // Reader interface
+  public:
+
+    // Get the latest published snapshot
+    // It stays valid until the same reader calls Quiesce()
+    __forceinline const CIniConfig &Get(void) const {
+      return *LoadAcquire(m_pCurrent);
+    };
+
+    // Report that a specific reader doesn't reference any snapshots anymore
+    __forceinline void Quiesce(INDEX iReader = 0) {
+      ASSERT(iReader >= 0 && iReader < m_ctReaders);
+      InterlockedExchange(&m_aiReaderEpochs[iReader], LoadAcquire(m_iEpoch));
+    };
+
+  // Writer interface
+  public:
+
+    // Publish a new snapshot in place of the current one and take ownership of it
+    // The snapshot is frozen before publishing, so it must not be changed afterwards
+    void Publish(CIniConfig *pNew) {
+      ASSERT(pNew != NULL);
+      pNew->Freeze();
+
+      CTSingleLock slWriters(&m_csWriters, TRUE);
+
+      // Swap the snapshots first and then advance the epoch, so readers that have seen the new epoch are using the new snapshot
+      CIniConfig *pOld = (CIniConfig *)InterlockedExchangePointer((PVOID volatile *)&m_pCurrent, pNew);
+
+      RetiredConfig retired;
+      retired.pConfig = pOld;
+      retired.iEpoch = InterlockedIncrement(&m_iEpoch);
+      m_aRetired.push_back(retired);
+
+      CollectLocked();
+    };
+
+    // Load a new snapshot from a file and publish it
+    void Reload_t(const CTString &strFile, bool bEngineStreams) {
+      CIniConfig *pNew = new CIniConfig;
+
+      try {
+        pNew->Load_t(strFile, bEngineStreams);
+
+      } catch (char *) {
+        delete pNew;
+        throw;
+      }
+
+      Publish(pNew);
+    };
+
+    // Save the current snapshot into a file
+    // Returns false without writing anything if no new snapshot has been published since the last save into the same file
+    bool SaveChanges_t(const CTString &strFile, bool bEngineStreams = true) {
+      CTSingleLock slWriters(&m_csWriters, TRUE);
+
+      // Only writers replace the snapshot and advance the epoch, so both stay the same under the lock
+      const LONG iEpoch = m_iEpoch;
+      if (iEpoch == m_iSavedEpoch && m_strSavedFile == strFile) return false;
+
+      IniStr strSave;
+      m_pCurrent->Write(strSave, true);
+      CIniConfig::WriteFile_t(strFile, bEngineStreams, strSave.c_str(), strSave.length());
+
+      m_iSavedEpoch = iEpoch;
+      m_strSavedFile = strFile;
+      return true;
+    };
+
+    // Delete replaced snapshots that aren't being read anymore
+    void Collect(void) {
+      CTSingleLock slWriters(&m_csWriters, TRUE);
+      CollectLocked();
+    };
+
+    // Count replaced snapshots that are still waiting to be deleted
+    size_t CountRetired(void) {
+      CTSingleLock slWriters(&m_csWriters, TRUE);
+      return m_aRetired.size();
+    };
+
+  private:
+    // Delete replaced snapshots that all readers have moved past
+    void CollectLocked(void) {
+      // Find the oldest epoch among the readers
+      LONG iMinEpoch = LoadAcquire(m_aiReaderEpochs[0]);
+
+      for (INDEX iReader = 1; iReader < m_ctReaders; iReader++) {
+        const LONG iEpoch = LoadAcquire(m_aiReaderEpochs[iReader]);
+        if (iEpoch < iMinEpoch) iMinEpoch = iEpoch;
+      }
+
+      // Keep snapshots that may still be in use
+      size_t ctKeep = 0;
+
+      for (size_t iRetired = 0; iRetired < m_aRetired.size(); iRetired++) {
+        RetiredConfig &retired = m_aRetired[iRetired];
+
+        if (retired.iEpoch <= iMinEpoch) {
+          delete retired.pConfig;
+        } else {
+          m_aRetired[ctKeep++] = retired;
+        }
+      }
+
+      m_aRetired.resize(ctKeep);
+    };
+};
+
+#endif
@@ -0,0 +1,439 @@
+/* Copyright (c) 2026 Dreamy Cecil
+This program is free software; you can redistribute it and/or modify
+it under the terms of version 2 of the GNU General Public License as published by
+the Free Software Foundation
+
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License along
+with this program; if not, write to the Free Software Foundation, Inc.,
+51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA. */
+
+#ifndef XGIZMO_INCL_STRINGBUILDER_H
+#define XGIZMO_INCL_STRINGBUILDER_H
+
+#ifdef PRAGMA_ONCE
+  #pragma once
+#endif
+
+#include "../Base/STLIncludesBegin.h"
+#include <algorithm>
+#include <new>
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "../Base/STLIncludesEnd.h"
+
+// Reusable string that text and numbers are appended to without any allocations until it outgrows its own buffer
+// Clearing it keeps the memory, so the same builder can format text every frame without touching the heap.
+class CStringBuilder {
+  public:
+    // Buffer size that fits any formatted number
+    enum { NUMBER_SIZE = 32 };
+
+  private:
+    enum { _INLINE_SIZE = 128 };
+
+    char m_aInline[_INLINE_SIZE]; // Own buffer for short strings
+    char *m_pchBuffer; // Current buffer (own or allocated)
+    size_t m_ctLength; // Amount of characters in the string
+    size_t m_ctCapacity; // Amount of characters that fit into the current buffer (without the null terminator)
+
+    // Cannot be copied
+    CStringBuilder(const CStringBuilder &);
+    void operator=(const CStringBuilder &);
+
+    // Make sure that some amount of characters can be appended
+    __forceinline void Reserve(size_t ctAdd) {
+      if (m_ctLength + ctAdd > m_ctCapacity) Grow(m_ctLength + ctAdd);
+    };
+
+    // Move the string into a bigger buffer
+    void Grow(size_t ctMin) {
+      size_t ctNew = m_ctCapacity * 2;
+      if (ctNew < ctMin) ctNew = ctMin;
+
+      char *pchNew = (char *)malloc(ctNew + 1);
+      if (pchNew == NULL) throw std::bad_alloc();
+
+      memcpy(pchNew, m_pchBuffer, m_ctLength + 1);
+      if (m_pchBuffer != m_aInline) free(m_pchBuffer);
+
+      m_pchBuffer = pchNew;
+      m_ctCapacity = ctNew;
+    };
+
+    // Get a power of 10 that is exact in a double (from 1e0 to 1e22)
+    static __forceinline DOUBLE Pow10(INDEX iPower) {
+      static const DOUBLE adPow10[23] = {
+        1e0,  1e1,  1e2,  1e3,  1e4,  1e5,  1e6,  1e7,  1e8,  1e9,  1e10, 1e11,
+        1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22,
+      };
+
+      ASSERT(iPower >= 0 && iPower <= 22);
+      return adPow10[iPower];
+    };
+
+    // Multiply a number by a power of 10 from 1e-22 to 1e22 (result is rounded only once)
+    static __forceinline DOUBLE Scale(DOUBLE d, INDEX iPower) {
+      return (iPower >= 0) ? d * Pow10(iPower) : d / Pow10(-iPower);
+    };
+
+    // Read back significant digits of a number with a decimal exponent of the first digit
+    static DOUBLE ReadDigits(UQUAD ullDigits, INDEX ctDigits, INDEX iExp) {
+      // If both digits and the power of 10 are exact in doubles, the result is the same as from reading the number
+      const INDEX iScale = ctDigits - 1 - iExp;
+
+      if (iScale >= -22 && iScale <= 22 && UQUAD(DOUBLE(ullDigits)) == ullDigits) {
+        return Scale(DOUBLE(ullDigits), -iScale);
+      }
+
+      // Otherwise it has to be actually read back, which only happens to very small or very big numbers
+      char aNumber[NUMBER_SIZE];
+      PrintDigits(aNumber, false, ullDigits, ctDigits, iExp);
+      return strtod(aNumber, NULL);
+    };
+
+    // Write significant digits of a number with a decimal exponent of the first digit like "%g" does
+    static size_t PrintDigits(char *pchOut, bool bNegative, UQUAD ullDigits, INDEX ctDigits, INDEX iExp) {
+      char aDigits[NUMBER_SIZE];
+      FormatUInt(aDigits, ullDigits);
+
+      // Drop trailing zeros
+      INDEX ctSignificant = ctDigits;
+      while (ctSignificant > 1 && aDigits[ctSignificant - 1] == '0') ctSignificant--;
+
+      char *pch = pchOut;
+      if (bNegative) *pch++ = '-';
+
+      // Exponential notation
+      if (iExp < -4 || iExp >= ctDigits) {
+        *pch++ = aDigits[0];
+
+        if (ctSignificant > 1) {
+          *pch++ = '.';
+          memcpy(pch, aDigits + 1, ctSignificant - 1);
+          pch += ctSignificant - 1;
+        }
+
+        *pch++ = 'e';
+        *pch++ = (iExp < 0) ? '-' : '+';
+
+        const INDEX iAbsExp = (iExp < 0) ? -iExp : iExp;
+        if (iAbsExp < 10) *pch++ = '0';
+
+        pch += FormatUInt(pch, iAbsExp);
+        return pch - pchOut;
+      }
+
+      // Whole part
+      if (iExp >= 0) {
+        memcpy(pch, aDigits, iExp + 1);
+        pch += iExp + 1;
+
+        if (ctSignificant > iExp + 1) {
+          *pch++ = '.';
+          memcpy(pch, aDigits + iExp + 1, ctSignificant - iExp - 1);
+          pch += ctSignificant - iExp - 1;
+        }
+
+      // Only the fraction
+      } else {
+        *pch++ = '0';
+        *pch++ = '.';
+
+        for (INDEX i = -1; i > iExp; i--) *pch++ = '0';
+
+        memcpy(pch, aDigits, ctSignificant);
+        pch += ctSignificant;
+      }
+
+      *pch = '\0';
+      return pch - pchOut;
+    };
+
+  public:
+    CStringBuilder() : m_pchBuffer(m_aInline), m_ctLength(0), m_ctCapacity(_INLINE_SIZE - 1)
+    {
+      m_aInline[0] = '\0';
+    };
+
+    ~CStringBuilder() {
+      if (m_pchBuffer != m_aInline) free(m_pchBuffer);
+    };
+
+    // Get the string
+    __forceinline const char *c_str(void) const { return m_pchBuffer; };
+
+    // Get amount of characters
+    __forceinline size_t Length(void) const { return m_ctLength; };
+
+    // Check if there are no characters
+    __forceinline bool IsEmpty(void) const { return m_ctLength == 0; };
+
+    // Remove all characters but keep the memory
+    __forceinline void Clear(void) {
+      m_ctLength = 0;
+      m_pchBuffer[0] = '\0';
+    };
+
+    // Append some characters
+    inline CStringBuilder &Add(const char *pch, size_t ct) {
+      Reserve(ct);
+      memcpy(m_pchBuffer + m_ctLength, pch, ct);
+
+      m_ctLength += ct;
+      m_pchBuffer[m_ctLength] = '\0';
+      return *this;
+    };
+
+    // Append a string
+    inline CStringBuilder &Add(const char *str) {
+      return Add(str, strlen(str));
+    };
+
+    // Append one character
+    inline CStringBuilder &Add(char ch) {
+      Reserve(1);
+      m_pchBuffer[m_ctLength++] = ch;
+      m_pchBuffer[m_ctLength] = '\0';
+      return *this;
+    };
+
+    // Append a signed integer
+    inline CStringBuilder &AddInt(__int64 i) {
+      char aBuffer[NUMBER_SIZE];
+      return Add(aBuffer, FormatInt(aBuffer, i));
+    };
+
+    // Append an unsigned integer
+    inline CStringBuilder &AddUInt(UQUAD i) {
+      char aBuffer[NUMBER_SIZE];
+      return Add(aBuffer, FormatUInt(aBuffer, i));
+    };
+
+    // Append an unsigned integer in uppercase hexadecimal with leading zeros up to some amount of digits
+    inline CStringBuilder &AddHex(UQUAD i, INDEX ctMinDigits = 0) {
+      char aBuffer[NUMBER_SIZE];
+      return Add(aBuffer, FormatHex(aBuffer, i, ctMinDigits));
+    };
+
+    // Append the shortest number that is read back as the same float
+    inline CStringBuilder &AddFloat(FLOAT f) {
+      char aBuffer[NUMBER_SIZE];
+      return Add(aBuffer, FormatFloat(aBuffer, f));
+    };
+
+    // Append the shortest number that is read back as the same double
+    inline CStringBuilder &AddDouble(DOUBLE d) {
+      char aBuffer[NUMBER_SIZE];
+      return Add(aBuffer, FormatDouble(aBuffer, d));
+    };
+
+  // Number formatting into a buffer of at least NUMBER_SIZE characters
+  // Each function returns amount of written characters without the null terminator
+  public:
+
+    static size_t FormatUInt(char *pchOut, UQUAD i) {
+      // Write digits from the end
+      char aDigits[NUMBER_SIZE];
+      char *pch = aDigits + NUMBER_SIZE;
+
+      do {
+        *--pch = char('0' + i % 10);
+        i /= 10;
+      } while (i != 0);
+
+      const size_t ct = aDigits + NUMBER_SIZE - pch;
+      memcpy(pchOut, pch, ct);
+      pchOut[ct] = '\0';
+      return ct;
+    };
+
+    static size_t FormatInt(char *pchOut, __int64 i) {
+      if (i >= 0) return FormatUInt(pchOut, UQUAD(i));
+
+      // Negate as unsigned to handle the smallest number
+      *pchOut = '-';
+      return FormatUInt(pchOut + 1, UQUAD(0) - UQUAD(i)) + 1;
+    };
+
+    static size_t FormatHex(char *pchOut, UQUAD i, INDEX ctMinDigits) {
+      char aDigits[NUMBER_SIZE];
+      char *pch = aDigits + NUMBER_SIZE;
+
+      do {
+        *--pch = "0123456789ABCDEF"[i & 0xF];
+        i >>= 4;
+        ctMinDigits--;
+      } while (i != 0 || ctMinDigits > 0);
+
+      const size_t ct = aDigits + NUMBER_SIZE - pch;
+      memcpy(pchOut, pch, ct);
+      pchOut[ct] = '\0';
+      return ct;
+    };
+
+    // Floats are written like "%g" but with as many digits as needed to be read back exactly
+    static size_t FormatFloat(char *pchOut, FLOAT f) {
+      // Whole numbers that "%g" wouldn't write with an exponent
+      if (f != 0.0f && f > -1e6f && f < 1e6f && f == FLOAT(SLONG(f))) {
+        return FormatInt(pchOut, SLONG(f));
+      }
+
+      const DOUBLE dAbs = (f < 0.0f) ? -DOUBLE(f) : DOUBLE(f);
+
+      // Round to some amount of significant digits and check if it's read back as the same float
+      // Any float can be represented in up to 9 digits and powers of 10 up to 1e22 are exact in doubles,
+      // so the result is the same as from reading the number, as long as it's within this range
+      if (dAbs >= 1e-13 && dAbs < 1e27) {
+        // Decimal exponent of the first digit
+        INDEX iExp = (INDEX)floor(log10(dAbs));
+
+        for (INDEX ctDigits = 6; ctDigits <= 9; ctDigits++) {
+          const INDEX iScale = ctDigits - 1 - iExp;
+          const DOUBLE dScaled = Scale(dAbs, iScale);
+
+          // Retry with a fixed exponent if it's off by one
+          if (dScaled < Pow10(ctDigits - 1)) {
+            iExp--;
+            ctDigits--;
+            continue;
+
+          } else if (dScaled >= Pow10(ctDigits)) {
+            iExp++;
+            ctDigits--;
+            continue;
+          }
+
+          // Round half to even like printf
+          UQUAD ullDigits = UQUAD(dScaled);
+          const DOUBLE dFraction = dScaled - DOUBLE(ullDigits);
+          if (dFraction > 0.5 || (dFraction == 0.5 && (ullDigits & 1))) ullDigits++;
+
+          if (FLOAT(Scale(DOUBLE(ullDigits), -iScale)) != FLOAT(dAbs)) continue;
+
+          // Rounded up to the next power of 10
+          INDEX iDigitsExp = iExp;
+
+          if (ullDigits >= UQUAD(Pow10(ctDigits))) {
+            ullDigits /= 10;
+            iDigitsExp++;
+          }
+
+          return PrintDigits(pchOut, f < 0.0f, ullDigits, ctDigits, iDigitsExp);
+        }
+      }
+
+      // Up to 9 digits are needed for any float
+      for (int iDigits = 6; iDigits < 9; iDigits++) {
+        const size_t ct = sprintf(pchOut, "%.*g", iDigits, f);
+        if (FLOAT(strtod(pchOut, NULL)) == f) return ct;
+      }
+
+      return sprintf(pchOut, "%.9g", f);
+    };
+
+    // Doubles are written like "%.15g" but with up to 17 digits, if needed to be read back exactly
+    // NOTE: Unlike "%g", whole numbers below 1e15 are written with all of their digits instead of an exponent.
+    static size_t FormatDouble(char *pchOut, DOUBLE d) {
+      // Whole numbers that "%.15g" wouldn't write with an exponent
+      if (d != 0.0 && d > -1e15 && d < 1e15 && d == DOUBLE(SQUAD(d))) {
+        return FormatInt(pchOut, SQUAD(d));
+      }
+
+      // Zeros, infinity and NaN
+      if (d == 0.0 || !(d - d == 0.0)) return sprintf(pchOut, "%g", d);
+
+      const bool bNegative = (d < 0.0);
+      const DOUBLE dAbs = bNegative ? -d : d;
+
+      // Round to 15 significant digits without printing, as long as powers of 10 are exact
+      // Only one number with 15 digits can be read back as the same double, so if it is, it's the same as from "%.15g"
+      if (dAbs >= 1e-7 && dAbs < 1e22) {
+        // Decimal exponent of the first digit
+        INDEX iExp = (INDEX)floor(log10(dAbs));
+        DOUBLE dScaled = Scale(dAbs, 14 - iExp);
+
+        // Fix the exponent if it's off by one
+        if (dScaled < 1e14) {
+          iExp--;
+          dScaled = Scale(dAbs, 14 - iExp);
+
+        } else if (dScaled >= 1e15) {
+          iExp++;
+          dScaled = Scale(dAbs, 14 - iExp);
+        }
+
+        UQUAD ullDigits = UQUAD(dScaled);
+        const DOUBLE dFraction = dScaled - DOUBLE(ullDigits);
+        if (dFraction > 0.5 || (dFraction == 0.5 && (ullDigits & 1))) ullDigits++;
+
+        // Rounded up to the next power of 10
+        if (ullDigits >= UQUAD(1e15)) {
+          ullDigits /= 10;
+          iExp++;
+        }
+
+        if (ReadDigits(ullDigits, 15, iExp) == dAbs) {
+          return PrintDigits(pchOut, bNegative, ullDigits, 15, iExp);
+        }
+      }
+
+      // Print more digits than needed once and pick the shortest rounding of them that is read back as the same double
+      char aPrinted[NUMBER_SIZE];
+      sprintf(aPrinted, "%.19e", d);
+
+      const char *pch = aPrinted;
+      if (bNegative) pch++;
+
+      char aDigits[20];
+      aDigits[0] = pch[0];
+      memcpy(aDigits + 1, pch + 2, 19);
+
+      const INDEX iPrintedExp = strtol(pch + 22, NULL, 10);
+
+      // Up to 17 digits are needed for any double
+      for (INDEX ctDigits = 15; ctDigits <= 17; ctDigits++) {
+        UQUAD ullDigits = 0;
+        for (INDEX i = 0; i < ctDigits; i++) ullDigits = ullDigits * 10 + (aDigits[i] - '0');
+
+        const char chNext = aDigits[ctDigits];
+        bool bAbove = false;
+        for (INDEX i = ctDigits + 1; i < 20; i++) bAbove |= (aDigits[i] != '0');
+
+        if (chNext > '5' || (chNext == '5' && bAbove)) ullDigits++;
+
+        // If the rest is exactly half, round it to even like printf but try rounding the other way as well,
+        // since the number itself may be slightly above or below it
+        const bool bHalf = (chNext == '5' && !bAbove);
+        UQUAD aullTries[2] = { ullDigits, ullDigits + 1 };
+        if (bHalf && (ullDigits & 1)) std::swap(aullTries[0], aullTries[1]);
+
+        for (INDEX iTry = 0; iTry < (bHalf ? 2 : 1); iTry++) {
+          UQUAD ullRounded = aullTries[iTry];
+          INDEX iExp = iPrintedExp;
+
+          // Rounded up to the next power of 10
+          if (ullRounded >= UQUAD(Pow10(ctDigits))) {
+            ullRounded /= 10;
+            iExp++;
+          }
+
+          // 17 correctly rounded digits are always read back the same way
+          if ((ctDigits == 17 && !bHalf) || ReadDigits(ullRounded, ctDigits, iExp) == dAbs) {
+            return PrintDigits(pchOut, bNegative, ullRounded, ctDigits, iExp);
+          }
+        }
+      }
+
+      return sprintf(pchOut, "%.17g", d);
+    };
+};
+
+#endif
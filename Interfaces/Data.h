@@ -21,6 +21,7 @@ with this program; if not, write to the Free Software Foundation, Inc.,
 #endif
 
 #include "Render.h"
+#include "../Base/StringBuilder.h"
 
 // Expandable array of strings
 typedef CStaticStackArray<CTString> CStringStack;
@@ -282,50 +283,45 @@ inline BOOL MatchesMask(const CTString &strString, CTString strMask) {
 };
 
 // Print out specific time in details (years, days, hours, minutes, seconds)
-inline void PrintDetailedTimeSec(CTString &strOut, __int64 iSeconds) {
+inline void PrintDetailedTimeSec(CStringBuilder &sb, __int64 iSeconds) {
   // Limit down to 0 seconds
   iSeconds = ClampDn(iSeconds, __int64(0));
 
   // Timeout
   if (iSeconds == 0) {
-    strOut = "0s";
+    sb.Add("0s");
     return;
   }
 
-  const ULONG ulSec = iSeconds % 60;
-  const ULONG ulMin = (iSeconds / 60) % 60;
-  const ULONG ulHours = (iSeconds / 3600) % 24;
-  const ULONG ulDaysTotal = iSeconds / 3600 / 24;
-  const ULONG ulDays = ulDaysTotal % 365;
-  const ULONG ulYearsTotal = (ulDaysTotal / 365);
+  const ULONG ulDaysTotal = ULONG(iSeconds / 3600 / 24);
 
-  strOut = "";
+  const ULONG aulTime[5] = {
+    ulDaysTotal / 365, // Years
+    ulDaysTotal % 365, // Days
+    ULONG((iSeconds / 3600) % 24), // Hours
+    ULONG((iSeconds / 60) % 60), // Minutes
+    ULONG(iSeconds % 60), // Seconds
+  };
 
-  // Display time
-  if (ulSec > 0) {
-    strOut.PrintF("%us", ulSec);
-  }
+  static const char *astrUnits[5] = { "yrs", "d", "h", "min", "s" };
+  bool bFirst = true;
 
-  if (ulMin > 0) {
-    if (strOut != "") strOut = " " + strOut;
-    strOut.PrintF("%umin%s", ulMin, strOut.str_String);
-  }
+  // Display non-zero units separated by spaces
+  for (INDEX i = 0; i < 5; i++) {
+    if (aulTime[i] == 0) continue;
 
-  if (ulHours > 0) {
-    if (strOut != "") strOut = " " + strOut;
-    strOut.PrintF("%uh%s", ulHours, strOut.str_String);
-  }
+    if (!bFirst) sb.Add(' ');
+    sb.AddUInt(aulTime[i]).Add(astrUnits[i]);
 
-  // Display days
-  if (ulDays > 0) {
-    if (strOut != "") strOut = " " + strOut;
-    strOut.PrintF("%ud%s", ulDays, strOut.str_String);
+    bFirst = false;
   }
+};
 
-  if (ulYearsTotal > 0) {
-    if (strOut != "") strOut = " " + strOut;
-    strOut.PrintF("%uyrs%s", ulYearsTotal, strOut.str_String);
-  }
+// Print out specific time in details (years, days, hours, minutes, seconds)
+inline void PrintDetailedTimeSec(CTString &strOut, __int64 iSeconds) {
+  CStringBuilder sb;
+  PrintDetailedTimeSec(sb, iSeconds);
+  strOut = sb.c_str();
 };
 
 // Print out specific time in details (years, days, hours, minutes, seconds)
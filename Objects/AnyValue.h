@@ -22,9 +22,33 @@ with this program; if not, write to the Free Software Foundation, Inc.,
 
 #include <Engine/Entities/EntityProperties.h>
 
+#include "Arena.h"
+#include "MapStructure.h"
+#include "../Base/StringBuilder.h"
+
+#include "../Base/STLIncludesBegin.h"
 #include <algorithm>
+#include <new>
+#include <string.h>
+#include <vector>
+
+namespace se1 {
+
+// Construct an object in preallocated memory
+// Defined here because placement new cannot be used while 'new' is redefined in debug
+template<class Type, class Arg> inline
+Type *construct_at(void *pMemory, const Arg &arg) {
+  return ::new (pMemory) Type(arg);
+};
+
+}; // namespace
+
+#include "../Base/STLIncludesEnd.h"
 
 // Type-safe container for single values of any type
+// Separate values can be created, copied and destroyed on different threads, unless they share the same holder.
+// NOTE: Define 'ANYVALUE_HOLDER_POOLS' before including this file to allocate holders of big values from pools instead of
+// the heap. Pools are shared by all values and have no locks, so values of big types may then only be used on one thread!
 class CAnyValue {
   public:
     // Rely on entity property types for supported types
@@ -52,15 +76,27 @@ class CAnyValue {
     };
 
     // Value placeholder
+    // Values keep their type themselves and don't call any of its methods, so it's only for code that uses holders directly
     struct Placeholder {
       virtual ~Placeholder() {};
       virtual EType GetType() const = 0;
       virtual Placeholder *Clone() const = 0;
     };
 
-    // Value holder of a specific type
+    // Placeholder that can be referenced by multiple values
+    struct RefCounter : public Placeholder {
+      ULONG _ctRefs;
+
+      RefCounter() : _ctRefs(1) {};
+    };
+
+    // Value holder of a specific type (only used for values that are too big to be stored inside CAnyValue or shared)
+    // Holders of values may be allocated from a separate pool for each type, while clones are allocated on the heap
     template<class Type, EType eType>
-    struct Holder : public Placeholder {
+    struct Holder : public RefCounter {
+      typedef Type ValueType;
+      enum { _TYPE = eType };
+
       Type _value;
 
       Holder(const Type &valSet) : _value(valSet) {};
@@ -83,131 +119,637 @@ class CAnyValue {
     typedef Holder<FLOATmatrix3D, E_VAL_MATRIX> Matrix_t;
 
   private:
-    Placeholder *_content; // Currently held value
+    friend class CAnyValueArray;
+
+    // Values that fit into this size are stored inside the value itself (everything up to planes and quaternions)
+    enum {
+      _INLINE_SIZE = (sizeof(FLOATplane3D) > sizeof(FLOATquat3D) ? sizeof(FLOATplane3D) : sizeof(FLOATquat3D)),
+    };
+
+    // Storage of the current value
+    union Storage {
+      char aInline[_INLINE_SIZE]; // Small value itself
+      RefCounter *pHeap; // Holder of a big or shared value
+      DOUBLE dAlign;
+    };
+
+    Storage _storage;
+    EType _eType; // Type of the current value
+    bool _bShared; // Value is in a holder that is shared with copies of it
+
+    // Check if values of some holder can be shared (big values and strings)
+    template<class HolderType> static __forceinline
+    bool CanShare(void) {
+      return !IsInline<HolderType>() || (EType)HolderType::_TYPE == E_VAL_STRING;
+    };
+
+    // Check if values of some holder are stored inside the value itself, unless shared
+    template<class HolderType> static __forceinline
+    bool IsInline(void) {
+      return sizeof(typename HolderType::ValueType) <= _INLINE_SIZE;
+    };
+
+    // Check if the current value of a specific holder type is in a holder
+    template<class HolderType> __forceinline
+    bool InHolder(void) const {
+      return !IsInline<HolderType>() || (CanShare<HolderType>() && _bShared);
+    };
+
+  #ifdef ANYVALUE_HOLDER_POOLS
+    // Get pool of holders of a specific type
+    template<class HolderType> static
+    se1::pool &Pool(void) {
+      static se1::pool _pool(sizeof(HolderType));
+      return _pool;
+    };
+  #endif
+
+    // Create a new holder of a specific type
+    template<class HolderType> static __forceinline
+    HolderType *NewHolder(const typename HolderType::ValueType &val) {
+    #ifdef ANYVALUE_HOLDER_POOLS
+      return se1::construct_at<HolderType>(Pool<HolderType>().allocate(), val);
+    #else
+      return new HolderType(val);
+    #endif
+    };
+
+    // Destroy a holder of a specific type
+    template<class HolderType> static __forceinline
+    void DeleteHolder(HolderType *pHolder) {
+    #ifdef ANYVALUE_HOLDER_POOLS
+      pHolder->~HolderType();
+      Pool<HolderType>().deallocate(pHolder);
+    #else
+      delete pHolder;
+    #endif
+    };
+
+    // Get the current value of a specific holder type without any checks
+    template<class HolderType> __forceinline
+    typename HolderType::ValueType &Value(void) const {
+      typedef typename HolderType::ValueType Type;
+
+      if (!InHolder<HolderType>()) {
+        return *(Type *)_storage.aInline;
+      }
+
+      return static_cast<HolderType *>(_storage.pHeap)->_value;
+    };
+
+    // Append a list of floats separated by commas
+    static void AddFloats(CStringBuilder &sb, const FLOAT *af, INDEX ct) {
+      for (INDEX i = 0; i < ct; i++) {
+        if (i != 0) sb.Add(", ");
+        sb.AddFloat(af[i]);
+      }
+    };
+
+    // Create a new value of a specific holder type (the current value must be destroyed beforehand)
+    template<class HolderType> __forceinline
+    void Create(const typename HolderType::ValueType &val) {
+      typedef typename HolderType::ValueType Type;
+
+      if (IsInline<HolderType>()) {
+        se1::construct_at<Type>(_storage.aInline, val);
+      } else {
+        _storage.pHeap = NewHolder<HolderType>(val);
+      }
+
+      _eType = (EType)HolderType::_TYPE;
+      _bShared = false;
+    };
+
+    // Destroy the current value of a specific holder type
+    template<class HolderType> __forceinline
+    void Destroy(void) {
+      typedef typename HolderType::ValueType Type;
+
+      if (!InHolder<HolderType>()) {
+        ((Type *)_storage.aInline)->~Type();
+      } else {
+        Release<HolderType>(static_cast<HolderType *>(_storage.pHeap));
+      }
+    };
+
+    // Stop referencing a holder of a specific type and destroy it, if it's not referenced anymore
+    template<class HolderType> static
+    void Release(HolderType *pHolder) {
+      if (--pHolder->_ctRefs == 0) {
+        DeleteHolder<HolderType>(pHolder);
+      }
+    };
+
+    // Stop sharing the current value of a specific holder type before it can be modified
+    // Mutable references may be held onto, so the value isn't shared with its future copies either
+    template<class HolderType>
+    void Unshare(void) {
+      if (!CanShare<HolderType>() || !_bShared) return;
+
+      typedef typename HolderType::ValueType Type;
+      HolderType *pHolder = static_cast<HolderType *>(_storage.pHeap);
+      _bShared = false;
+
+      // Move small values back inside
+      if (IsInline<HolderType>()) {
+        se1::construct_at<Type>(_storage.aInline, pHolder->_value);
+
+      // Keep the holder if it's the only reference to it
+      } else if (pHolder->_ctRefs == 1) {
+        return;
+
+      // Make own copy
+      } else {
+        _storage.pHeap = NewHolder<HolderType>(pHolder->_value);
+      }
+
+      Release<HolderType>(pHolder);
+    };
+
+    // Start sharing the current value of a specific holder type
+    template<class HolderType>
+    void Share(void) {
+      if (!CanShare<HolderType>() || _bShared) return;
+
+      // Move small values into a holder
+      if (IsInline<HolderType>()) {
+        typedef typename HolderType::ValueType Type;
+        Type &val = *(Type *)_storage.aInline;
+
+        HolderType *pHolder = NewHolder<HolderType>(val);
+        val.~Type();
+
+        _storage.pHeap = pHolder;
+      }
+
+      _bShared = true;
+    };
+
+    // Copy value from another container (the current value must be destroyed beforehand)
+    void CopyFrom(const CAnyValue &other) {
+      // Reference the same holder
+      if (other._bShared) {
+        _storage.pHeap = other._storage.pHeap;
+        _storage.pHeap->_ctRefs++;
+
+        _eType = other._eType;
+        _bShared = true;
+        return;
+      }
+
+      switch (other._eType) {
+        case E_VAL_NULL: _eType = E_VAL_NULL; _bShared = false; break;
+        case E_VAL_BOOL:   Create<Bool_t  >(other.Value<Bool_t  >()); break;
+        case E_VAL_INDEX:  Create<Int_t   >(other.Value<Int_t   >()); break;
+        case E_VAL_FLOAT:  Create<Float_t >(other.Value<Float_t >()); break;
+        case E_VAL_DOUBLE: Create<Double_t>(other.Value<Double_t>()); break;
+        case E_VAL_STRING: Create<String_t>(other.Value<String_t>()); break;
+        case E_VAL_PTR:    Create<Ptr_t   >(other.Value<Ptr_t   >()); break;
+        case E_VAL_VECTOR: Create<Vector_t>(other.Value<Vector_t>()); break;
+        case E_VAL_PLANE:  Create<Plane_t >(other.Value<Plane_t >()); break;
+        case E_VAL_PLACE:  Create<Place_t >(other.Value<Place_t >()); break;
+        case E_VAL_BOX:    Create<Box_t   >(other.Value<Box_t   >()); break;
+        case E_VAL_QUAT:   Create<Quat_t  >(other.Value<Quat_t  >()); break;
+        case E_VAL_MATRIX: Create<Matrix_t>(other.Value<Matrix_t>()); break;
+        default: ASSERTALWAYS("Unknown value type in CAnyValue::CopyFrom()");
+      }
+    };
+
+    // Destroy the current value
+    void Clear(void) {
+      switch (_eType) {
+        case E_VAL_NULL: break;
+        case E_VAL_BOOL:   Destroy<Bool_t  >(); break;
+        case E_VAL_INDEX:  Destroy<Int_t   >(); break;
+        case E_VAL_FLOAT:  Destroy<Float_t >(); break;
+        case E_VAL_DOUBLE: Destroy<Double_t>(); break;
+        case E_VAL_STRING: Destroy<String_t>(); break;
+        case E_VAL_PTR:    Destroy<Ptr_t   >(); break;
+        case E_VAL_VECTOR: Destroy<Vector_t>(); break;
+        case E_VAL_PLANE:  Destroy<Plane_t >(); break;
+        case E_VAL_PLACE:  Destroy<Place_t >(); break;
+        case E_VAL_BOX:    Destroy<Box_t   >(); break;
+        case E_VAL_QUAT:   Destroy<Quat_t  >(); break;
+        case E_VAL_MATRIX: Destroy<Matrix_t>(); break;
+        default: ASSERTALWAYS("Unknown value type in CAnyValue::Clear()");
+      }
+
+      _eType = E_VAL_NULL;
+      _bShared = false;
+    };
+
+  public:
+    // Get pool of holders for values of some type (returns NULL if values of this type aren't allocated from a pool)
+  #ifdef ANYVALUE_HOLDER_POOLS
+    static const se1::pool *GetPool(EType eType) {
+      switch (eType) {
+        case E_VAL_STRING: return &Pool<String_t>(); // Only shared strings
+        case E_VAL_PLACE:  return &Pool<Place_t >();
+        case E_VAL_BOX:    return &Pool<Box_t   >();
+        case E_VAL_MATRIX: return &Pool<Matrix_t>();
+      }
+
+      return NULL;
+    };
+  #else
+    static const se1::pool *GetPool(EType) {
+      return NULL;
+    };
+  #endif
 
   public:
     // Default constructor
-    CAnyValue() : _content(NULL) {};
+    CAnyValue() : _eType(E_VAL_NULL), _bShared(false) {};
 
     // Constructors from supported types
-    CAnyValue(bool   bSet) : _content(new Bool_t  (bSet)) {};
-    CAnyValue(int    iSet) : _content(new Int_t   (iSet)) {};
-    CAnyValue(float  fSet) : _content(new Float_t (fSet)) {};
-    CAnyValue(double fSet) : _content(new Double_t(fSet)) {};
-    CAnyValue(const CTString &strSet) : _content(new String_t(strSet)) {};
-    CAnyValue(const char     *strSet) : _content(new String_t(strSet)) {};
-    CAnyValue(void             *pSet) : _content(new Ptr_t(pSet)) {};
-
-    CAnyValue(const FLOAT3D       &vSet)   : _content(new Vector_t(vSet)) {};
-    CAnyValue(const FLOATplane3D  &plSet)  : _content(new Plane_t (plSet)) {};
-    CAnyValue(const CPlacement3D  &plSet)  : _content(new Place_t (plSet)) {};
-    CAnyValue(const FLOATaabbox3D &boxSet) : _content(new Box_t   (boxSet)) {};
-    CAnyValue(const FLOATquat3D   &qSet)   : _content(new Quat_t  (qSet)) {};
-    CAnyValue(const FLOATmatrix3D &mSet)   : _content(new Matrix_t(mSet)) {};
+    CAnyValue(bool   bSet) { Create<Bool_t  >(bSet); };
+    CAnyValue(int    iSet) { Create<Int_t   >(iSet); };
+    CAnyValue(float  fSet) { Create<Float_t >(fSet); };
+    CAnyValue(double fSet) { Create<Double_t>(fSet); };
+    CAnyValue(const CTString &strSet) { Create<String_t>(strSet); };
+    CAnyValue(const char     *strSet) { Create<String_t>(strSet); };
+    CAnyValue(void             *pSet) { Create<Ptr_t   >(pSet); };
+
+    CAnyValue(const FLOAT3D       &vSet)   { Create<Vector_t>(vSet); };
+    CAnyValue(const FLOATplane3D  &plSet)  { Create<Plane_t >(plSet); };
+    CAnyValue(const CPlacement3D  &plSet)  { Create<Place_t >(plSet); };
+    CAnyValue(const FLOATaabbox3D &boxSet) { Create<Box_t   >(boxSet); };
+    CAnyValue(const FLOATquat3D   &qSet)   { Create<Quat_t  >(qSet); };
+    CAnyValue(const FLOATmatrix3D &mSet)   { Create<Matrix_t>(mSet); };
 
     // Copy constructor
-    CAnyValue(const CAnyValue &other) : _content(!other.IsEmpty() ? other._content->Clone() : NULL) {};
+    CAnyValue(const CAnyValue &other) {
+      CopyFrom(other);
+    };
 
     // Destructor
     ~CAnyValue() {
-      delete _content;
+      Clear();
     };
 
   public:
     // Get value type
-    inline EType GetType() const {
-      return !IsEmpty() ? _content->GetType() : E_VAL_NULL;
+    __forceinline EType GetType() const {
+      return _eType;
     };
 
     // Swap values
     inline void Swap(CAnyValue &other) {
-      std::swap(_content, other._content);
+      // Strings only hold a pointer to their characters, so every value can be moved around as raw memory
+      std::swap(_storage, other._storage);
+      std::swap(_eType, other._eType);
+      std::swap(_bShared, other._bShared);
     };
 
-    // Assign a new value by swapping values with a temporary copy
+    // Assign a new value by copying it into own storage
     inline CAnyValue &operator=(const CAnyValue &other) {
-      CAnyValue(other).Swap(*this);
+      if (this != &other) {
+        Clear();
+        CopyFrom(other);
+      }
+
       return *this;
     };
 
     // Check if value is empty
-    inline bool IsEmpty() const {
-      return _content == NULL;
+    __forceinline bool IsEmpty() const {
+      return _eType == E_VAL_NULL;
+    };
+
+    // Let copies of this value reference the same holder instead of copying it (only strings and big values)
+    // The value stays shared until any copy calls a mutable accessor, which makes an own copy of it for that copy.
+    // NOTE: Reference counting isn't thread-safe, so shared values shouldn't be copied from multiple threads!
+    void MakeShared(void) {
+      switch (_eType) {
+        case E_VAL_STRING: Share<String_t>(); break;
+        case E_VAL_PLACE:  Share<Place_t >(); break;
+        case E_VAL_BOX:    Share<Box_t   >(); break;
+        case E_VAL_MATRIX: Share<Matrix_t>(); break;
+      }
+    };
+
+    // Check if copies of this value reference the same holder
+    __forceinline bool IsShared() const {
+      return _bShared;
+    };
+
+    // Count values that reference the same holder as this one (1 if it isn't shared)
+    ULONG CountRefs(void) const {
+      return _bShared ? _storage.pHeap->_ctRefs : 1;
+    };
+
+  // Value visiting
+  // Visitors are functors with 'operator()' for each value type they accept (or a template for any type)
+  // that return a type defined as 'Result'. Booleans are passed as 'bool' and empty values as 'NullValue'.
+  public:
+    // Type of empty values for visitors
+    struct NullValue {};
+
+  private:
+    // Call a visitor with the current value of a container
+    template<class Visitor> static __forceinline
+    typename Visitor::Result Dispatch(const CAnyValue &val, Visitor &vis) {
+      switch (val._eType) {
+        case E_VAL_BOOL:   return vis(val.Value<Bool_t>() != 0);
+        case E_VAL_INDEX:  return vis(val.Value<Int_t   >());
+        case E_VAL_FLOAT:  return vis(val.Value<Float_t >());
+        case E_VAL_DOUBLE: return vis(val.Value<Double_t>());
+        case E_VAL_STRING: return vis(val.Value<String_t>());
+        case E_VAL_PTR:    return vis(val.Value<Ptr_t   >());
+        case E_VAL_VECTOR: return vis(val.Value<Vector_t>());
+        case E_VAL_PLANE:  return vis(val.Value<Plane_t >());
+        case E_VAL_PLACE:  return vis(val.Value<Place_t >());
+        case E_VAL_BOX:    return vis(val.Value<Box_t   >());
+        case E_VAL_QUAT:   return vis(val.Value<Quat_t  >());
+        case E_VAL_MATRIX: return vis(val.Value<Matrix_t>());
+      }
+
+      ASSERT(val._eType == E_VAL_NULL);
+      return vis(NullValue());
+    };
+
+  public:
+    // Call a visitor with the current value of its actual type and return its result
+    template<class Visitor> inline
+    typename Visitor::Result Visit(Visitor &vis) const {
+      return Dispatch(*this, vis);
+    };
+
+    // Call a temporary visitor with the current value of its actual type and return its result
+    template<class Visitor> inline
+    typename Visitor::Result Visit(const Visitor &vis) const {
+      return Dispatch(*this, vis);
     };
 
   // Value accessors
+  // Typed access to the current value, if its holder type is known at compile time (e.g. 'Get<CAnyValue::Matrix_t>()')
   public:
 
+    template<class HolderType> inline
+    typename HolderType::ValueType &Get(void) {
+      ASSERT(GetType() == (EType)HolderType::_TYPE);
+      Unshare<HolderType>();
+      return Value<HolderType>();
+    };
+
+    template<class HolderType> inline
+    const typename HolderType::ValueType &Get(void) const {
+      ASSERT(GetType() == (EType)HolderType::_TYPE);
+      return Value<HolderType>();
+    };
+
+    // Get the current value only if it's of a specific holder type (returns NULL otherwise)
+    template<class HolderType> inline
+    typename HolderType::ValueType *TryGet(void) {
+      if (GetType() != (EType)HolderType::_TYPE) return NULL;
+
+      Unshare<HolderType>();
+      return &Value<HolderType>();
+    };
+
+    template<class HolderType> inline
+    const typename HolderType::ValueType *TryGet(void) const {
+      if (GetType() != (EType)HolderType::_TYPE) return NULL;
+      return &Value<HolderType>();
+    };
+
     inline INDEX &GetIndex(void) {
       ASSERT(GetType() == E_VAL_BOOL || GetType() == E_VAL_INDEX);
-      return ((Int_t *)_content)->_value;
+      return Value<Int_t>();
     };
 
-    inline FLOAT &GetFloat(void) {
-      ASSERT(GetType() == E_VAL_FLOAT);
-      return ((Float_t *)_content)->_value;
-    };
+    inline FLOAT         &GetFloat    (void) { return Get<Float_t >(); };
+    inline DOUBLE        &GetDouble   (void) { return Get<Double_t>(); };
+    inline CTString      &GetString   (void) { return Get<String_t>(); };
+    inline void         *&GetPtr      (void) { return Get<Ptr_t   >(); };
+    inline FLOAT3D       &GetVector   (void) { return Get<Vector_t>(); };
+    inline FLOATplane3D  &GetPlane    (void) { return Get<Plane_t >(); };
+    inline CPlacement3D  &GetPlacement(void) { return Get<Place_t >(); };
+    inline FLOATaabbox3D &GetBox      (void) { return Get<Box_t   >(); };
+    inline FLOATquat3D   &GetQuat     (void) { return Get<Quat_t  >(); };
+    inline FLOATmatrix3D &GetMatrix   (void) { return Get<Matrix_t>(); };
+
+  // Converter visitors (types without overloads are passed into the template and cannot be converted)
+  private:
 
-    inline DOUBLE &GetDouble(void) {
-      ASSERT(GetType() == E_VAL_DOUBLE);
-      return ((Double_t *)_content)->_value;
+    struct TruthVisitor {
+      typedef bool Result;
+
+      bool operator()(bool b)              const { return b; };
+      bool operator()(INDEX i)             const { return i != 0; };
+      bool operator()(FLOAT f)             const { return f != 0.0f; };
+      bool operator()(DOUBLE f)            const { return f != 0.0; };
+      bool operator()(const CTString &str) const { return str.Length() != 0; };
+      bool operator()(void *p)             const { return p != NULL; };
+
+      template<class Type>
+      bool operator()(const Type &) const {
+        ASSERTALWAYS("Unknown value type in CAnyValue::IsTrue()");
+        return false;
+      };
     };
 
-    inline CTString &GetString(void) {
-      ASSERT(GetType() == E_VAL_STRING);
-      return ((String_t *)_content)->_value;
+    // Converts to INDEX or DOUBLE
+    template<class Number>
+    struct NumberVisitor {
+      typedef Number Result;
+
+      Number operator()(bool b)     const { return (Number)b; };
+      Number operator()(INDEX i)    const { return (Number)i; };
+      Number operator()(FLOAT f)    const { return (Number)f; };
+      Number operator()(DOUBLE f)   const { return (Number)f; };
+
+      template<class Type>
+      Number operator()(const Type &) const {
+        ASSERTALWAYS("Unknown value type in CAnyValue::ToIndex() or CAnyValue::ToFloat()");
+        return 0;
+      };
     };
 
-    inline void *&GetPtr(void) {
-      ASSERT(GetType() == E_VAL_PTR);
-      return ((Ptr_t *)_content)->_value;
+    struct TextVisitor {
+      typedef void Result;
+      CStringBuilder &sb;
+
+      TextVisitor(CStringBuilder &sbSet) : sb(sbSet) {};
+
+      void operator()(bool b)              const { sb.Add(b ? '1' : '0'); };
+      void operator()(INDEX i)             const { sb.AddInt(i); };
+      void operator()(FLOAT f)             const { sb.AddFloat(f); };
+      void operator()(DOUBLE f)            const { sb.AddDouble(f); };
+      void operator()(const CTString &str) const { sb.Add(str.str_String); };
+      void operator()(void *p)             const { sb.Add("0x").AddHex((size_t)p, sizeof(void *) * 2); };
+
+      void operator()(const FLOAT3D &v) const {
+        sb.Add("v[");
+        AddFloats(sb, &v(1), 3);
+        sb.Add(']');
+      };
+
+      void operator()(const FLOATplane3D &pl) const {
+        sb.Add("pl[");
+        AddFloats(sb, &pl(1), 3);
+        sb.Add("; ->").AddFloat(pl.pl_distance).Add(']');
+      };
+
+      void operator()(const CPlacement3D &pl) const {
+        sb.Add("pl[");
+        AddFloats(sb, &pl.pl_PositionVector(1), 3);
+        sb.Add(";  ");
+        AddFloats(sb, &pl.pl_OrientationAngle(1), 3);
+        sb.Add(']');
+      };
+
+      void operator()(const FLOATaabbox3D &box) const {
+        sb.Add("b[");
+        AddFloats(sb, &box.Min()(1), 3);
+        sb.Add(";  ");
+        AddFloats(sb, &box.Max()(1), 3);
+        sb.Add(']');
+      };
+
+      void operator()(const FLOATquat3D &q) const {
+        sb.Add("q[").AddFloat(q.q_w).Add(", ").AddFloat(q.q_x).Add(", ").AddFloat(q.q_y).Add(", ").AddFloat(q.q_z).Add(']');
+      };
+
+      void operator()(const FLOATmatrix3D &m) const {
+        sb.Add("m[");
+        AddFloats(sb, &m(1, 1), 3);
+        sb.Add(";  ");
+        AddFloats(sb, &m(2, 1), 3);
+        sb.Add(";  ");
+        AddFloats(sb, &m(3, 1), 3);
+        sb.Add(']');
+      };
+
+      void operator()(const NullValue &) const {
+        ASSERTALWAYS("Unknown value type in CAnyValue::ToString()");
+      };
     };
 
-    inline FLOAT3D &GetVector(void) {
-      ASSERT(GetType() == E_VAL_VECTOR);
-      return ((Vector_t *)_content)->_value;
+    struct VectorVisitor {
+      typedef FLOAT3D Result;
+
+      FLOAT3D operator()(const FLOAT3D &v) const { return v; };
+
+      // Plane normal
+      FLOAT3D operator()(const FLOATplane3D &pl) const { return (const FLOAT3D &)pl; };
+
+      // Placement position
+      FLOAT3D operator()(const CPlacement3D &pl) const { return pl.pl_PositionVector; };
+
+      // Matrix to rotation angles
+      FLOAT3D operator()(const FLOATmatrix3D &m) const {
+        ANGLE3D v;
+        DecomposeRotationMatrixNoSnap(v, m);
+        return v;
+      };
+
+      template<class Type>
+      FLOAT3D operator()(const Type &) const {
+        ASSERTALWAYS("Unknown value type in CAnyValue::ToVector()");
+        return FLOAT3D(0, 0, 0);
+      };
     };
 
-    inline FLOATplane3D &GetPlane(void) {
-      ASSERT(GetType() == E_VAL_PLANE);
-      return ((Plane_t *)_content)->_value;
+    struct PlaneVisitor {
+      typedef FLOATplane3D Result;
+
+      // Direction with 1 meter length
+      FLOATplane3D operator()(const FLOAT3D &v) const { return FLOATplane3D(v, 1.0f); };
+
+      FLOATplane3D operator()(const FLOATplane3D &pl) const { return pl; };
+
+      template<class Type>
+      FLOATplane3D operator()(const Type &) const {
+        ASSERTALWAYS("Unknown value type in CAnyValue::ToPlane()");
+        return FLOATplane3D(FLOAT3D(0, 1, 0), 1.0f);
+      };
     };
 
-    inline CPlacement3D &GetPlacement(void) {
-      ASSERT(GetType() == E_VAL_PLACE);
-      return ((Place_t *)_content)->_value;
+    struct PlacementVisitor {
+      typedef CPlacement3D Result;
+
+      // Position without rotation
+      CPlacement3D operator()(const FLOAT3D &v) const { return CPlacement3D(v, ANGLE3D(0, 0, 0)); };
+
+      CPlacement3D operator()(const CPlacement3D &pl) const { return pl; };
+
+      template<class Type>
+      CPlacement3D operator()(const Type &) const {
+        ASSERTALWAYS("Unknown value type in CAnyValue::ToPlacement()");
+        return CPlacement3D(FLOAT3D(0, 0, 0), ANGLE3D(0, 0, 0));
+      };
     };
 
-    inline FLOATaabbox3D &GetBox(void) {
-      ASSERT(GetType() == E_VAL_BOX);
-      return ((Box_t *)_content)->_value;
+    struct BoxVisitor {
+      typedef FLOATaabbox3D Result;
+
+      FLOATaabbox3D operator()(const FLOATaabbox3D &box) const { return box; };
+
+      template<class Type>
+      FLOATaabbox3D operator()(const Type &) const {
+        ASSERTALWAYS("Unknown value type in CAnyValue::ToBox()");
+        return FLOATaabbox3D(FLOAT3D(0, 0, 0), 0.0f);
+      };
     };
 
-    inline FLOATquat3D &GetQuat(void) {
-      ASSERT(GetType() == E_VAL_QUAT);
-      return ((Quat_t *)_content)->_value;
+    struct QuatVisitor {
+      typedef FLOATquat3D Result;
+
+      FLOATquat3D operator()(const FLOATquat3D &q) const { return q; };
+
+      // Quaternion conversion
+      FLOATquat3D operator()(const FLOATmatrix3D &m) const {
+        FLOATquat3D q;
+        q.FromMatrix(m);
+        return q;
+      };
+
+      template<class Type>
+      FLOATquat3D operator()(const Type &) const {
+        ASSERTALWAYS("Unknown value type in CAnyValue::ToQuat()");
+        return FLOATquat3D(0, 0, 0, 0);
+      };
     };
 
-    inline FLOATmatrix3D &GetMatrix(void) {
-      ASSERT(GetType() == E_VAL_MATRIX);
-      return ((Matrix_t *)_content)->_value;
+    struct MatrixVisitor {
+      typedef FLOATmatrix3D Result;
+
+      // Rotation angles to matrix
+      FLOATmatrix3D operator()(const FLOAT3D &v) const {
+        FLOATmatrix3D m;
+        MakeRotationMatrix(m, v);
+        return m;
+      };
+
+      // Placement rotation to matrix
+      FLOATmatrix3D operator()(const CPlacement3D &pl) const {
+        FLOATmatrix3D m;
+        MakeRotationMatrix(m, pl.pl_OrientationAngle);
+        return m;
+      };
+
+      // Quaternion conversion
+      FLOATmatrix3D operator()(const FLOATquat3D &q) const {
+        FLOATmatrix3D m;
+        q.ToMatrix(m);
+        return m;
+      };
+
+      FLOATmatrix3D operator()(const FLOATmatrix3D &m) const { return m; };
+
+      template<class Type>
+      FLOATmatrix3D operator()(const Type &) const {
+        ASSERTALWAYS("Unknown value type in CAnyValue::ToMatrix()");
+        return FLOATmatrix3D(0);
+      };
     };
-    
+
   // Value converters
   public:
 
     inline bool IsTrue(void) const {
-      switch (GetType()) {
-        case E_VAL_BOOL:
-        case E_VAL_INDEX:  return ((Int_t    *)_content)->_value != 0;
-        case E_VAL_FLOAT:  return ((Float_t  *)_content)->_value != 0.0f;
-        case E_VAL_DOUBLE: return ((Double_t *)_content)->_value != 0.0;
-        case E_VAL_STRING: return ((String_t *)_content)->_value.Length() != 0;
-        case E_VAL_PTR:    return ((Ptr_t    *)_content)->_value != NULL;
-      }
-
-      ASSERTALWAYS("Unknown value type in CAnyValue::IsTrue()");
-      return false;
+      return Visit(TruthVisitor());
     };
 
     // Implicit conversion
@@ -216,177 +758,419 @@ class CAnyValue {
     };
 
     inline INDEX ToIndex(void) const {
-      switch (GetType()) {
-        case E_VAL_BOOL:
-        case E_VAL_INDEX:  return ((Int_t    *)_content)->_value;
-        case E_VAL_FLOAT:  return ((Float_t  *)_content)->_value;
-        case E_VAL_DOUBLE: return ((Double_t *)_content)->_value;
-      }
-
-      ASSERTALWAYS("Unknown value type in CAnyValue::ToIndex()");
-      return 0;
+      return Visit(NumberVisitor<INDEX>());
     };
 
     inline DOUBLE ToFloat(void) const {
-      switch (GetType()) {
-        case E_VAL_BOOL:
-        case E_VAL_INDEX:  return ((Int_t    *)_content)->_value;
-        case E_VAL_FLOAT:  return ((Float_t  *)_content)->_value;
-        case E_VAL_DOUBLE: return ((Double_t *)_content)->_value;
-      }
+      return Visit(NumberVisitor<DOUBLE>());
+    };
 
-      ASSERTALWAYS("Unknown value type in CAnyValue::ToFloat()");
-      return 0.0;
+    // Append value as text to a string builder
+    void ToString(CStringBuilder &sb) const {
+      Visit(TextVisitor(sb));
     };
 
     inline CTString ToString(void) const {
-      switch (GetType()) {
-        case E_VAL_BOOL:   return ((Int_t *)_content)->_value ? "1" : "0";
-        case E_VAL_INDEX:  return CTString(0, "%d", ((Int_t    *)_content)->_value);
-        case E_VAL_FLOAT:  return CTString(0, "%g", ((Float_t  *)_content)->_value);
-        case E_VAL_DOUBLE: return CTString(0, "%g", ((Double_t *)_content)->_value);
-        case E_VAL_STRING: return ((String_t *)_content)->_value;
-        case E_VAL_PTR:    return CTString(0, "0x%p", ((Ptr_t  *)_content)->_value);
-
-        case E_VAL_VECTOR: {
-          const FLOAT3D &v = ((Vector_t *)_content)->_value;
-          return CTString(0, "v[%g, %g, %g]", v(1), v(2), v(3));
-        }
+      // Strings don't need to be formatted
+      if (GetType() == E_VAL_STRING) return Value<String_t>();
+
+      CStringBuilder sb;
+      ToString(sb);
+      return sb.c_str();
+    };
+
+    inline FLOAT3D       ToVector   (void) const { return Visit(VectorVisitor()); };
+    inline FLOATplane3D  ToPlane    (void) const { return Visit(PlaneVisitor()); };
+    inline CPlacement3D  ToPlacement(void) const { return Visit(PlacementVisitor()); };
+    inline FLOATaabbox3D ToBox      (void) const { return Visit(BoxVisitor()); };
+    inline FLOATquat3D   ToQuat     (void) const { return Visit(QuatVisitor()); };
+    inline FLOATmatrix3D ToMatrix   (void) const { return Visit(MatrixVisitor()); };
+
+  // Comparison and hashing
+  // Values of different types are never equal and are ordered by their type. Floats are compared by their bits,
+  // so 0 and -0 are different values and NaN is equal to itself, while the order is still the numerical one.
+  // Strings are compared with case sensitivity, unlike CTString itself.
+  private:
+    // Get address of the current value
+    const void *ValuePtr(void) const {
+      switch (_eType) {
+        case E_VAL_BOOL:   return &Value<Bool_t  >();
+        case E_VAL_INDEX:  return &Value<Int_t   >();
+        case E_VAL_FLOAT:  return &Value<Float_t >();
+        case E_VAL_DOUBLE: return &Value<Double_t>();
+        case E_VAL_STRING: return &Value<String_t>();
+        case E_VAL_PTR:    return &Value<Ptr_t   >();
+        case E_VAL_VECTOR: return &Value<Vector_t>();
+        case E_VAL_PLANE:  return &Value<Plane_t >();
+        case E_VAL_PLACE:  return &Value<Place_t >();
+        case E_VAL_BOX:    return &Value<Box_t   >();
+        case E_VAL_QUAT:   return &Value<Quat_t  >();
+        case E_VAL_MATRIX: return &Value<Matrix_t>();
+      }
+
+      return NULL;
+    };
+
+    // Map bits of a float onto an integer that is ordered the same way as the float
+    static __forceinline ULONG FloatOrder(ULONG ul) {
+      return (ul & 0x80000000UL) ? ~ul : (ul | 0x80000000UL);
+    };
 
-        case E_VAL_PLANE: {
-          const FLOATplane3D &pl = ((Plane_t *)_content)->_value;
-          return CTString(0, "pl[%g, %g, %g; ->%g]", pl(1), pl(2), pl(3), pl.pl_distance);
+    static __forceinline UQUAD DoubleOrder(UQUAD uq) {
+      const UQUAD uqSign = UQUAD(1) << 63;
+      return (uq & uqSign) ? ~uq : (uq | uqSign);
+    };
+
+    // Compare two values of the same type
+    static INDEX CompareValues(EType eType, const void *pValue1, const void *pValue2) {
+      switch (eType) {
+        case E_VAL_BOOL: {
+          const INDEX b1 = (*(const INDEX *)pValue1 != 0);
+          const INDEX b2 = (*(const INDEX *)pValue2 != 0);
+          return b1 - b2;
         }
 
-        case E_VAL_PLACE: {
-          const CPlacement3D &pl = ((Place_t *)_content)->_value;
-          return CTString(0, "pl[%g, %g, %g;  %g, %g, %g]",
-            pl.pl_PositionVector(1),   pl.pl_PositionVector(2),   pl.pl_PositionVector(3),
-            pl.pl_OrientationAngle(1), pl.pl_OrientationAngle(2), pl.pl_OrientationAngle(3));
+        case E_VAL_INDEX: {
+          const INDEX i1 = *(const INDEX *)pValue1;
+          const INDEX i2 = *(const INDEX *)pValue2;
+          return (i1 < i2) ? -1 : (i1 > i2);
         }
 
-        case E_VAL_BOX: {
-          const FLOATaabbox3D &box = ((Box_t *)_content)->_value;
-          return CTString(0, "b[%g, %g, %g;  %g, %g, %g]",
-            box.Min()(1), box.Min()(2), box.Min()(3), box.Max()(1), box.Max()(2), box.Max()(3));
+        case E_VAL_DOUBLE: {
+          const UQUAD uq1 = DoubleOrder(*(const UQUAD *)pValue1);
+          const UQUAD uq2 = DoubleOrder(*(const UQUAD *)pValue2);
+          return (uq1 < uq2) ? -1 : (uq1 > uq2);
         }
 
-        case E_VAL_QUAT: {
-          const FLOATquat3D &q = ((Quat_t *)_content)->_value;
-          return CTString(0, "q[%g, %g, %g, %g]", q.q_w, q.q_x, q.q_y, q.q_z);
+        case E_VAL_STRING: {
+          const INDEX iCmp = strcmp(((const CTString *)pValue1)->str_String, ((const CTString *)pValue2)->str_String);
+          return (iCmp < 0) ? -1 : (iCmp > 0);
         }
 
-        case E_VAL_MATRIX: {
-          const FLOATmatrix3D &m = ((Matrix_t *)_content)->_value;
-          return CTString(0, "m[%g, %g, %g;  %g, %g, %g;  %g, %g, %g]",
-            m(1, 1), m(1, 2), m(1, 3), m(2, 1), m(2, 2), m(2, 3), m(3, 1), m(3, 2), m(3, 3));
+        case E_VAL_PTR: {
+          const size_t p1 = *(const size_t *)pValue1;
+          const size_t p2 = *(const size_t *)pValue2;
+          return (p1 < p2) ? -1 : (p1 > p2);
         }
       }
 
-      ASSERTALWAYS("Unknown value type in CAnyValue::ToString()");
-      return "";
+      // Everything else is a list of floats
+      ASSERT(IsRawValue(eType));
+      const ULONG *aul1 = (const ULONG *)pValue1;
+      const ULONG *aul2 = (const ULONG *)pValue2;
+      const size_t ct = ValueSize(eType) / sizeof(ULONG);
+
+      for (size_t i = 0; i < ct; i++) {
+        if (aul1[i] == aul2[i]) continue;
+        return (FloatOrder(aul1[i]) < FloatOrder(aul2[i])) ? -1 : 1;
+      }
+
+      return 0;
     };
 
-    inline FLOAT3D ToVector(void) const {
-      switch (GetType()) {
-        case E_VAL_VECTOR: return ((Vector_t *)_content)->_value;
+    // Mix a list of 32-bit words into a hash
+    static __forceinline size_t HashWords(size_t iHash, const ULONG *aul, size_t ct) {
+      for (size_t i = 0; i < ct; i++) {
+        iHash = (iHash ^ aul[i]) * size_t(0x9E3779B1U);
+        iHash ^= iHash >> 15;
+      }
+
+      return iHash;
+    };
 
-        // Plane normal
-        case E_VAL_PLANE: return (FLOAT3D &)((Plane_t *)_content)->_value;
+  public:
+    // Compare with another value (returns -1 if this one goes before it, 1 if after and 0 if they are equal)
+    INDEX Compare(const CAnyValue &other) const {
+      if (_eType != other._eType) return (_eType < other._eType) ? -1 : 1;
+      if (_eType == E_VAL_NULL) return 0;
 
-        // Placement position
-        case E_VAL_PLACE: return ((Place_t *)_content)->_value.pl_PositionVector;
+      // Same holder
+      if (_bShared && other._bShared && _storage.pHeap == other._storage.pHeap) return 0;
 
-        // Matrix to rotation angles
-        case E_VAL_MATRIX: {
-          ANGLE3D v;
-          DecomposeRotationMatrixNoSnap(v, ((Matrix_t *)_content)->_value);
-          return v;
+      return CompareValues(_eType, ValuePtr(), other.ValuePtr());
+    };
+
+    inline bool operator==(const CAnyValue &other) const { return Compare(other) == 0; };
+    inline bool operator!=(const CAnyValue &other) const { return Compare(other) != 0; };
+    inline bool operator< (const CAnyValue &other) const { return Compare(other) <  0; };
+    inline bool operator> (const CAnyValue &other) const { return Compare(other) >  0; };
+    inline bool operator<=(const CAnyValue &other) const { return Compare(other) <= 0; };
+    inline bool operator>=(const CAnyValue &other) const { return Compare(other) >= 0; };
+
+    // Compute hash of the value (equal values always have equal hashes)
+    size_t Hash(void) const {
+      const size_t iType = _eType;
+
+      switch (_eType) {
+        case E_VAL_NULL: return 0;
+
+        case E_VAL_BOOL: {
+          const ULONG ul = (Value<Bool_t>() != 0);
+          return HashWords(iType, &ul, 1);
+        }
+
+        case E_VAL_STRING: {
+          const char *str = Value<String_t>().str_String;
+          return se1::HashChars(str, strlen(str)) ^ iType;
         }
       }
 
-      ASSERTALWAYS("Unknown value type in CAnyValue::ToVector()");
-      return FLOAT3D(0, 0, 0);
+      // Integers, pointers, floats and spatial types are hashed by their bits
+      return HashWords(iType, (const ULONG *)ValuePtr(), ValueSize(_eType) / sizeof(ULONG));
     };
 
-    inline FLOATplane3D ToPlane(void) const {
-      switch (GetType()) {
-        // Direction with 1 meter length
-        case E_VAL_VECTOR: return FLOATplane3D(((Vector_t *)_content)->_value, 1.0f);
+  // Binary serialization
+  // Values are written as a one-byte type followed by the value: integers and lengths as variable-length integers,
+  // floats and spatial types as raw IEEE floats and strings as their length followed by characters
+  private:
+    // Get size of a value of some type (returns 0 for unknown types)
+    static size_t ValueSize(EType eType) {
+      switch (eType) {
+        case E_VAL_BOOL:
+        case E_VAL_INDEX:  return sizeof(INDEX);
+        case E_VAL_FLOAT:  return sizeof(FLOAT);
+        case E_VAL_DOUBLE: return sizeof(DOUBLE);
+        case E_VAL_STRING: return sizeof(CTString);
+        case E_VAL_PTR:    return sizeof(void *);
+        case E_VAL_VECTOR: return sizeof(FLOAT3D);
+        case E_VAL_PLANE:  return sizeof(FLOATplane3D);
+        case E_VAL_PLACE:  return sizeof(CPlacement3D);
+        case E_VAL_BOX:    return sizeof(FLOATaabbox3D);
+        case E_VAL_QUAT:   return sizeof(FLOATquat3D);
+        case E_VAL_MATRIX: return sizeof(FLOATmatrix3D);
+      }
+
+      return 0;
+    };
 
-        case E_VAL_PLANE: return ((Plane_t *)_content)->_value;
+    // Check if values of some type are written as they are in memory
+    static bool IsRawValue(EType eType) {
+      switch (eType) {
+        case E_VAL_FLOAT: case E_VAL_DOUBLE:
+        case E_VAL_VECTOR: case E_VAL_PLANE: case E_VAL_PLACE:
+        case E_VAL_BOX: case E_VAL_QUAT: case E_VAL_MATRIX:
+          return true;
       }
 
-      ASSERTALWAYS("Unknown value type in CAnyValue::ToPlane()");
-      return FLOATplane3D(FLOAT3D(0, 1, 0), 1.0f);
+      return false;
     };
 
-    inline CPlacement3D ToPlacement(void) const {
-      switch (GetType()) {
-        // Position without rotation
-        case E_VAL_VECTOR: return CPlacement3D(((Vector_t *)_content)->_value, ANGLE3D(0, 0, 0));
+    // Write variable-length integer (7 bits per byte with the high bit set if there are more bytes)
+    static void WriteVarint_t(CTStream &strm, ULONG ul) {
+      UBYTE aub[(sizeof(ULONG) * 8 + 6) / 7];
+      INDEX ct = 0;
 
-        case E_VAL_PLACE: return ((Place_t *)_content)->_value;
+      while (ul >= 0x80) {
+        aub[ct++] = UBYTE(ul | 0x80);
+        ul >>= 7;
       }
 
-      ASSERTALWAYS("Unknown value type in CAnyValue::ToPlacement()");
-      return CPlacement3D(FLOAT3D(0, 0, 0), ANGLE3D(0, 0, 0));
+      aub[ct++] = UBYTE(ul);
+      strm.Write_t(aub, ct);
     };
 
-    inline FLOATaabbox3D ToBox(void) const {
-      switch (GetType()) {
-        case E_VAL_BOX: return ((Box_t *)_content)->_value;
+    // Read variable-length integer
+    static ULONG ReadVarint_t(CTStream &strm) {
+      ULONG ul = 0;
+
+      for (INDEX iShift = 0; iShift < INDEX(sizeof(ULONG) * 8); iShift += 7) {
+        UBYTE ub;
+        strm.Read_t(&ub, 1);
+
+        ul |= ULONG(ub & 0x7F) << iShift;
+        if (!(ub & 0x80)) return ul;
       }
 
-      ASSERTALWAYS("Unknown value type in CAnyValue::ToBox()");
-      return FLOATaabbox3D(FLOAT3D(0, 0, 0), 0.0f);
+      ThrowF_t((char *)TRANSV("Invalid variable-length integer"));
+      return 0;
     };
 
-    inline FLOATquat3D ToQuat(void) const {
-      switch (GetType()) {
-        case E_VAL_QUAT: return ((Quat_t *)_content)->_value;
+    // Read amount of bytes or elements that follow it in a stream
+    static ULONG ReadCount_t(CTStream &strm) {
+      const ULONG ct = ReadVarint_t(strm);
 
-        // Quaternion conversion
-        case E_VAL_MATRIX: {
-          FLOATquat3D q;
-          q.FromMatrix(((Matrix_t *)_content)->_value);
-          return q;
-        }
+      // Each element takes at least one byte
+      if (ct > ULONG(strm.GetStreamSize() - strm.GetPos_t())) {
+        ThrowF_t((char *)TRANSV("Invalid amount of elements: %u"), ct);
       }
 
-      ASSERTALWAYS("Unknown value type in CAnyValue::ToQuat()");
-      return FLOATquat3D(0, 0, 0, 0);
+      return ct;
     };
 
-    inline FLOATmatrix3D ToMatrix(void) const {
-      switch (GetType()) {
-        // Rotation angles to matrix
-        case E_VAL_VECTOR: {
-          FLOATmatrix3D m;
-          MakeRotationMatrix(m, ((Vector_t *)_content)->_value);
-          return m;
-        }
+    // Write value of some type from memory
+    static void WriteValue_t(CTStream &strm, EType eType, const void *pValue) {
+      switch (eType) {
+        case E_VAL_BOOL: {
+          const UBYTE ub = (*(const INDEX *)pValue != 0);
+          strm.Write_t(&ub, 1);
+        } return;
+
+        // Zigzag encoding, so small negative numbers are short as well
+        case E_VAL_INDEX: {
+          const SLONG sl = *(const INDEX *)pValue;
+          WriteVarint_t(strm, (ULONG(sl) << 1) ^ ULONG(sl >> (sizeof(SLONG) * 8 - 1)));
+        } return;
+
+        case E_VAL_STRING: {
+          const char *str = ((const CTString *)pValue)->str_String;
+          const ULONG ct = (ULONG)strlen(str);
+
+          WriteVarint_t(strm, ct);
+          if (ct != 0) strm.Write_t(str, ct);
+        } return;
+
+        case E_VAL_PTR: {
+          ThrowF_t((char *)TRANSV("Pointer values cannot be serialized"));
+        } return;
+      }
 
-        // Placement rotation to matrix
-        case E_VAL_PLACE: {
-          FLOATmatrix3D m;
-          MakeRotationMatrix(m, ((Place_t *)_content)->_value.pl_OrientationAngle);
-          return m;
-        }
+      ASSERT(IsRawValue(eType));
+      strm.Write_t(pValue, ValueSize(eType));
+    };
 
-        // Quaternion conversion
-        case E_VAL_QUAT: {
-          FLOATmatrix3D m;
-          ((Quat_t *)_content)->_value.ToMatrix(m);
-          return m;
-        }
+    // Read value of some type into memory
+    static void ReadValue_t(CTStream &strm, EType eType, void *pValue) {
+      switch (eType) {
+        case E_VAL_BOOL: {
+          UBYTE ub;
+          strm.Read_t(&ub, 1);
+          *(INDEX *)pValue = (ub != 0);
+        } return;
+
+        case E_VAL_INDEX: {
+          const ULONG ul = ReadVarint_t(strm);
+          *(INDEX *)pValue = SLONG(ul >> 1) ^ -SLONG(ul & 1);
+        } return;
+
+        case E_VAL_STRING: {
+          const ULONG ct = ReadCount_t(strm);
+          std::vector<char> aBuffer(ct + 1);
+
+          if (ct != 0) strm.Read_t(&aBuffer[0], ct);
+          aBuffer[ct] = '\0';
+
+          *(CTString *)pValue = &aBuffer[0];
+        } return;
+
+        case E_VAL_PTR: {
+          ThrowF_t((char *)TRANSV("Pointer values cannot be serialized"));
+        } return;
+      }
+
+      ASSERT(IsRawValue(eType));
+      strm.Read_t(pValue, ValueSize(eType));
+    };
 
-        case E_VAL_MATRIX: return ((Matrix_t *)_content)->_value;
+    // Read value of a specific holder type
+    template<class HolderType>
+    void ReadAs_t(CTStream &strm) {
+      typename HolderType::ValueType val;
+      ReadValue_t(strm, (EType)HolderType::_TYPE, &val);
+
+      Clear();
+      Create<HolderType>(val);
+    };
+
+  public:
+    // Write value into a stream
+    void Write_t(CTStream &strm) const {
+      const UBYTE ubType = (UBYTE)_eType;
+      strm.Write_t(&ubType, 1);
+
+      switch (_eType) {
+        case E_VAL_NULL: break;
+        case E_VAL_BOOL:   WriteValue_t(strm, _eType, &Value<Bool_t  >()); break;
+        case E_VAL_INDEX:  WriteValue_t(strm, _eType, &Value<Int_t   >()); break;
+        case E_VAL_FLOAT:  WriteValue_t(strm, _eType, &Value<Float_t >()); break;
+        case E_VAL_DOUBLE: WriteValue_t(strm, _eType, &Value<Double_t>()); break;
+        case E_VAL_STRING: WriteValue_t(strm, _eType, &Value<String_t>()); break;
+        case E_VAL_PTR:    WriteValue_t(strm, _eType, &Value<Ptr_t   >()); break;
+        case E_VAL_VECTOR: WriteValue_t(strm, _eType, &Value<Vector_t>()); break;
+        case E_VAL_PLANE:  WriteValue_t(strm, _eType, &Value<Plane_t >()); break;
+        case E_VAL_PLACE:  WriteValue_t(strm, _eType, &Value<Place_t >()); break;
+        case E_VAL_BOX:    WriteValue_t(strm, _eType, &Value<Box_t   >()); break;
+        case E_VAL_QUAT:   WriteValue_t(strm, _eType, &Value<Quat_t  >()); break;
+        case E_VAL_MATRIX: WriteValue_t(strm, _eType, &Value<Matrix_t>()); break;
+        default: ASSERTALWAYS("Unknown value type in CAnyValue::Write_t()");
+      }
+    };
+
+    // Read value from a stream
+    void Read_t(CTStream &strm) {
+      UBYTE ubType;
+      strm.Read_t(&ubType, 1);
+
+      switch (ubType) {
+        case E_VAL_NULL: Clear(); break;
+        case E_VAL_BOOL:   ReadAs_t<Bool_t  >(strm); break;
+        case E_VAL_INDEX:  ReadAs_t<Int_t   >(strm); break;
+        case E_VAL_FLOAT:  ReadAs_t<Float_t >(strm); break;
+        case E_VAL_DOUBLE: ReadAs_t<Double_t>(strm); break;
+        case E_VAL_STRING: ReadAs_t<String_t>(strm); break;
+        case E_VAL_PTR:    ReadAs_t<Ptr_t   >(strm); break;
+        case E_VAL_VECTOR: ReadAs_t<Vector_t>(strm); break;
+        case E_VAL_PLANE:  ReadAs_t<Plane_t >(strm); break;
+        case E_VAL_PLACE:  ReadAs_t<Place_t >(strm); break;
+        case E_VAL_BOX:    ReadAs_t<Box_t   >(strm); break;
+        case E_VAL_QUAT:   ReadAs_t<Quat_t  >(strm); break;
+        case E_VAL_MATRIX: ReadAs_t<Matrix_t>(strm); break;
+        default: ThrowF_t((char *)TRANSV("Unknown value type %d"), ubType);
+      }
+    };
+
+    // Write a list of values into a stream
+    static void WriteList_t(CTStream &strm, const std::vector<CAnyValue> &aValues) {
+      const ULONG ct = (ULONG)aValues.size();
+      WriteVarint_t(strm, ct);
+
+      for (ULONG i = 0; i < ct; i++) {
+        aValues[i].Write_t(strm);
+      }
+    };
+
+    // Read a list of values from a stream
+    static void ReadList_t(CTStream &strm, std::vector<CAnyValue> &aValues) {
+      const ULONG ct = ReadCount_t(strm);
+      aValues.clear();
+      aValues.resize(ct);
+
+      for (ULONG i = 0; i < ct; i++) {
+        aValues[i].Read_t(strm);
       }
+    };
+
+    // Write values under string keys into a stream
+    static void WriteMap_t(CTStream &strm, const se1::map<CTString, CAnyValue> &mapValues) {
+      WriteVarint_t(strm, (ULONG)mapValues.size());
+      se1::map<CTString, CAnyValue>::const_iterator it;
 
-      ASSERTALWAYS("Unknown value type in CAnyValue::ToMatrix()");
-      return FLOATmatrix3D(0);
+      for (it = mapValues.begin(); it != mapValues.end(); it++) {
+        WriteValue_t(strm, E_VAL_STRING, &it->first);
+        it->second.Write_t(strm);
+      }
     };
+
+    // Read values under string keys from a stream
+    static void ReadMap_t(CTStream &strm, se1::map<CTString, CAnyValue> &mapValues) {
+      const ULONG ct = ReadCount_t(strm);
+      mapValues.clear();
+
+      for (ULONG i = 0; i < ct; i++) {
+        CTString strKey;
+        ReadValue_t(strm, E_VAL_STRING, &strKey);
+        mapValues[strKey].Read_t(strm);
+      }
+    };
+};
+
+namespace se1 {
+
+// Values of any type are compared by their type and contents
+template<>
+struct map_hash<CAnyValue> {
+  size_t operator()(const CAnyValue &key) const { return key.Hash(); };
 };
 
+}; // namespace
+
 #endif
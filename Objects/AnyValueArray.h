@@ -0,0 +1,582 @@
+/* Copyright (c) 2026 Dreamy Cecil
+This program is free software; you can redistribute it and/or modify
+it under the terms of version 2 of the GNU General Public License as published by
+the Free Software Foundation
+
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License along
+with this program; if not, write to the Free Software Foundation, Inc.,
+51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA. */
+
+#ifndef XGIZMO_INCL_ANYVALUEARRAY_H
+#define XGIZMO_INCL_ANYVALUEARRAY_H
+
+#ifdef PRAGMA_ONCE
+  #pragma once
+#endif
+
+#include "AnyValue.h"
+
+#include "../Base/STLIncludesBegin.h"
+#include <stdlib.h>
+#include <string.h>
+#include "../Base/STLIncludesEnd.h"
+
+namespace se1 {
+
+// Typed view of contiguous elements
+template<class Type>
+class span {
+  private:
+    Type *_pData;
+    size_t _ctSize;
+
+  public:
+    span(Type *pData = NULL, size_t ctSize = 0) : _pData(pData), _ctSize(ctSize) {};
+
+    inline Type *data(void) const { return _pData; };
+    inline size_t size(void) const { return _ctSize; };
+    inline bool empty(void) const { return _ctSize == 0; };
+
+    inline Type *begin(void) const { return _pData; };
+    inline Type *end(void) const { return _pData + _ctSize; };
+
+    inline Type &operator[](size_t i) const {
+      ASSERT(i < _ctSize);
+      return _pData[i];
+    };
+};
+
+}; // namespace
+
+// Array of values of the same type that are stored contiguously instead of being held by separate CAnyValue objects
+// Spatial types are stored as a structure of arrays: every float component of a value (e.g. X, Y and Z of a vector)
+// has its own column of floats in the order they are stored in the engine type. Other types are stored as plain arrays.
+class CAnyValueArray {
+  public:
+    typedef CAnyValue::EType EType;
+
+  private:
+    EType m_eType; // Type of all values
+    size_t m_ctElementSize; // Size of one value
+
+    char *m_pData; // Values or columns of their components
+    INDEX m_ctCount; // Amount of values
+    INDEX m_ctAllocated; // Amount of values that fit into allocated memory
+
+  private:
+    // Check if values of some type are split into columns of float components
+    static bool IsSpatial(EType eType) {
+      switch (eType) {
+        case CAnyValue::E_VAL_VECTOR: case CAnyValue::E_VAL_PLANE: case CAnyValue::E_VAL_PLACE:
+        case CAnyValue::E_VAL_BOX: case CAnyValue::E_VAL_QUAT: case CAnyValue::E_VAL_MATRIX:
+          return true;
+      }
+
+      return false;
+    };
+
+    // Get non-spatial values as an array of a specific holder type without any checks
+    template<class HolderType> __forceinline
+    typename HolderType::ValueType *Values(void) const {
+      return (typename HolderType::ValueType *)m_pData;
+    };
+
+    // Get one column of components of spatial values without any checks
+    __forceinline FLOAT *Column(INDEX iComponent) const {
+      return (FLOAT *)m_pData + iComponent * m_ctAllocated;
+    };
+
+    // Gather components of some spatial value into memory
+    void LoadElement(INDEX iValue, FLOAT *afValue) const {
+      const INDEX ctColumns = CountColumns();
+
+      for (INDEX iComponent = 0; iComponent < ctColumns; iComponent++) {
+        afValue[iComponent] = Column(iComponent)[iValue];
+      }
+    };
+
+    // Scatter components of some spatial value from memory
+    void StoreElement(INDEX iValue, const FLOAT *afValue) {
+      const INDEX ctColumns = CountColumns();
+
+      for (INDEX iComponent = 0; iComponent < ctColumns; iComponent++) {
+        Column(iComponent)[iValue] = afValue[iComponent];
+      }
+    };
+
+    // Get values as a span of a specific holder type
+    template<class HolderType> inline
+    se1::span<typename HolderType::ValueType> Span(void) const {
+      ASSERT(m_eType == (EType)HolderType::_TYPE);
+      return se1::span<typename HolderType::ValueType>(Values<HolderType>(), m_ctCount);
+    };
+
+    // Create a CAnyValue from some value of a specific holder type
+    template<class HolderType> inline
+    CAnyValue GetAs(INDEX iValue) const {
+      CAnyValue val;
+
+      if (IsSpatial((EType)HolderType::_TYPE)) {
+        typename HolderType::ValueType valSpatial;
+        LoadElement(iValue, (FLOAT *)&valSpatial);
+        val.Create<HolderType>(valSpatial);
+
+      } else {
+        val.Create<HolderType>(Values<HolderType>()[iValue]);
+      }
+
+      return val;
+    };
+
+    // Replace some value with a value of a specific holder type from CAnyValue
+    template<class HolderType> inline
+    void SetAs(INDEX iValue, const CAnyValue &val) {
+      if (IsSpatial((EType)HolderType::_TYPE)) {
+        StoreElement(iValue, (const FLOAT *)&val.Value<HolderType>());
+      } else {
+        Values<HolderType>()[iValue] = val.Value<HolderType>();
+      }
+    };
+
+    // Add a new value of a specific holder type from CAnyValue
+    template<class HolderType> inline
+    void AddAs(const CAnyValue &val) {
+      if (m_ctCount == m_ctAllocated) Reserve(m_ctAllocated > 0 ? m_ctAllocated * 2 : 16);
+
+      if (IsSpatial((EType)HolderType::_TYPE)) {
+        StoreElement(m_ctCount, (const FLOAT *)&val.Value<HolderType>());
+      } else {
+        se1::construct_at<typename HolderType::ValueType>(Values<HolderType>() + m_ctCount, val.Value<HolderType>());
+      }
+
+      m_ctCount++;
+    };
+
+    // Copy values from another array (values must be cleared beforehand)
+    void CopyFrom(const CAnyValueArray &other) {
+      SetType(other.m_eType);
+      Reserve(other.m_ctCount);
+
+      if (m_eType == CAnyValue::E_VAL_STRING) {
+        const CTString *astrOther = other.Values<CAnyValue::String_t>();
+        CTString *astr = Values<CAnyValue::String_t>();
+
+        for (INDEX i = 0; i < other.m_ctCount; i++) {
+          se1::construct_at<CTString>(astr + i, astrOther[i]);
+        }
+
+      } else if (other.m_ctCount != 0) {
+        // Columns may be spaced differently in both arrays
+        if (IsSpatial(m_eType)) {
+          const INDEX ctColumns = CountColumns();
+
+          for (INDEX iComponent = 0; iComponent < ctColumns; iComponent++) {
+            memcpy(Column(iComponent), other.Column(iComponent), other.m_ctCount * sizeof(FLOAT));
+          }
+
+        } else {
+          memcpy(m_pData, other.m_pData, other.m_ctCount * m_ctElementSize);
+        }
+      }
+
+      m_ctCount = other.m_ctCount;
+    };
+
+  public:
+    // Constructor with a type of all values
+    CAnyValueArray(EType eType = CAnyValue::E_VAL_NULL) :
+      m_eType(eType), m_ctElementSize(CAnyValue::ValueSize(eType)), m_pData(NULL), m_ctCount(0), m_ctAllocated(0)
+    {
+    };
+
+    // Copy constructor
+    CAnyValueArray(const CAnyValueArray &other) :
+      m_eType(CAnyValue::E_VAL_NULL), m_ctElementSize(0), m_pData(NULL), m_ctCount(0), m_ctAllocated(0)
+    {
+      CopyFrom(other);
+    };
+
+    // Destructor
+    ~CAnyValueArray() {
+      Clear();
+      free(m_pData);
+    };
+
+    // Assignment
+    CAnyValueArray &operator=(const CAnyValueArray &other) {
+      if (this != &other) {
+        Clear();
+        CopyFrom(other);
+      }
+
+      return *this;
+    };
+
+    // Get type of all values
+    inline EType GetType(void) const {
+      return m_eType;
+    };
+
+    // Remove all values and change their type
+    void SetType(EType eType) {
+      Clear();
+
+      if (m_eType != eType) {
+        free(m_pData);
+        m_pData = NULL;
+        m_ctAllocated = 0;
+
+        m_eType = eType;
+        m_ctElementSize = CAnyValue::ValueSize(eType);
+      }
+    };
+
+    // Get amount of values
+    inline INDEX Count(void) const {
+      return m_ctCount;
+    };
+
+    // Check if there are no values
+    inline bool IsEmpty(void) const {
+      return m_ctCount == 0;
+    };
+
+    // Get amount of component columns of spatial values (0 for other types)
+    inline INDEX CountColumns(void) const {
+      return IsSpatial(m_eType) ? INDEX(m_ctElementSize / sizeof(FLOAT)) : 0;
+    };
+
+    // Remove all values but keep allocated memory
+    void Clear(void) {
+      if (m_eType == CAnyValue::E_VAL_STRING) {
+        CTString *astr = Values<CAnyValue::String_t>();
+        for (INDEX i = 0; i < m_ctCount; i++) astr[i].~CTString();
+      }
+
+      m_ctCount = 0;
+    };
+
+    // Allocate memory for some amount of values
+    void Reserve(INDEX ct) {
+      if (ct <= m_ctAllocated) return;
+      ASSERT(m_eType != CAnyValue::E_VAL_NULL);
+
+      char *pNewData = (char *)malloc(ct * m_ctElementSize);
+      if (pNewData == NULL) throw std::bad_alloc();
+
+      if (m_ctCount != 0) {
+        // Columns are spaced by the amount of allocated values, so each one is moved to its new place
+        if (IsSpatial(m_eType)) {
+          const INDEX ctColumns = CountColumns();
+
+          for (INDEX iComponent = 0; iComponent < ctColumns; iComponent++) {
+            memcpy((FLOAT *)pNewData + iComponent * ct, Column(iComponent), m_ctCount * sizeof(FLOAT));
+          }
+
+        // Strings only hold a pointer to their characters, so every value can be moved around as raw memory
+        } else {
+          memcpy(pNewData, m_pData, m_ctCount * m_ctElementSize);
+        }
+      }
+
+      free(m_pData);
+      m_pData = pNewData;
+      m_ctAllocated = ct;
+    };
+
+    // Change amount of values (new strings are empty and other new values are zeroed)
+    void Resize(INDEX ct) {
+      if (ct < m_ctCount) {
+        if (m_eType == CAnyValue::E_VAL_STRING) {
+          CTString *astr = Values<CAnyValue::String_t>();
+          for (INDEX i = ct; i < m_ctCount; i++) astr[i].~CTString();
+        }
+
+        m_ctCount = ct;
+        return;
+      }
+
+      Reserve(ct);
+
+      if (m_eType == CAnyValue::E_VAL_STRING) {
+        CTString *astr = Values<CAnyValue::String_t>();
+        for (INDEX i = m_ctCount; i < ct; i++) se1::construct_at<CTString>(astr + i, "");
+
+      } else if (IsSpatial(m_eType)) {
+        const INDEX ctColumns = CountColumns();
+
+        for (INDEX iComponent = 0; iComponent < ctColumns; iComponent++) {
+          memset(Column(iComponent) + m_ctCount, 0, (ct - m_ctCount) * sizeof(FLOAT));
+        }
+
+      } else {
+        memset(m_pData + m_ctCount * m_ctElementSize, 0, (ct - m_ctCount) * m_ctElementSize);
+      }
+
+      m_ctCount = ct;
+    };
+
+    // Add a new value (the array takes its type if it doesn't have one yet)
+    void Add(const CAnyValue &val) {
+      if (m_eType == CAnyValue::E_VAL_NULL) SetType(val.GetType());
+      ASSERT(val.GetType() == m_eType);
+
+      switch (m_eType) {
+        case CAnyValue::E_VAL_BOOL:   AddAs<CAnyValue::Bool_t  >(val); break;
+        case CAnyValue::E_VAL_INDEX:  AddAs<CAnyValue::Int_t   >(val); break;
+        case CAnyValue::E_VAL_FLOAT:  AddAs<CAnyValue::Float_t >(val); break;
+        case CAnyValue::E_VAL_DOUBLE: AddAs<CAnyValue::Double_t>(val); break;
+        case CAnyValue::E_VAL_STRING: AddAs<CAnyValue::String_t>(val); break;
+        case CAnyValue::E_VAL_PTR:    AddAs<CAnyValue::Ptr_t   >(val); break;
+        case CAnyValue::E_VAL_VECTOR: AddAs<CAnyValue::Vector_t>(val); break;
+        case CAnyValue::E_VAL_PLANE:  AddAs<CAnyValue::Plane_t >(val); break;
+        case CAnyValue::E_VAL_PLACE:  AddAs<CAnyValue::Place_t >(val); break;
+        case CAnyValue::E_VAL_BOX:    AddAs<CAnyValue::Box_t   >(val); break;
+        case CAnyValue::E_VAL_QUAT:   AddAs<CAnyValue::Quat_t  >(val); break;
+        case CAnyValue::E_VAL_MATRIX: AddAs<CAnyValue::Matrix_t>(val); break;
+        default: ASSERTALWAYS("Unknown value type in CAnyValueArray::Add()");
+      }
+    };
+
+    // Get some value
+    CAnyValue Get(INDEX iValue) const {
+      ASSERT(iValue >= 0 && iValue < m_ctCount);
+
+      switch (m_eType) {
+        case CAnyValue::E_VAL_BOOL:   return GetAs<CAnyValue::Bool_t  >(iValue);
+        case CAnyValue::E_VAL_INDEX:  return GetAs<CAnyValue::Int_t   >(iValue);
+        case CAnyValue::E_VAL_FLOAT:  return GetAs<CAnyValue::Float_t >(iValue);
+        case CAnyValue::E_VAL_DOUBLE: return GetAs<CAnyValue::Double_t>(iValue);
+        case CAnyValue::E_VAL_STRING: return GetAs<CAnyValue::String_t>(iValue);
+        case CAnyValue::E_VAL_PTR:    return GetAs<CAnyValue::Ptr_t   >(iValue);
+        case CAnyValue::E_VAL_VECTOR: return GetAs<CAnyValue::Vector_t>(iValue);
+        case CAnyValue::E_VAL_PLANE:  return GetAs<CAnyValue::Plane_t >(iValue);
+        case CAnyValue::E_VAL_PLACE:  return GetAs<CAnyValue::Place_t >(iValue);
+        case CAnyValue::E_VAL_BOX:    return GetAs<CAnyValue::Box_t   >(iValue);
+        case CAnyValue::E_VAL_QUAT:   return GetAs<CAnyValue::Quat_t  >(iValue);
+        case CAnyValue::E_VAL_MATRIX: return GetAs<CAnyValue::Matrix_t>(iValue);
+      }
+
+      ASSERTALWAYS("Unknown value type in CAnyValueArray::Get()");
+      return CAnyValue();
+    };
+
+    // Replace some value with another value of the same type
+    void Set(INDEX iValue, const CAnyValue &val) {
+      ASSERT(iValue >= 0 && iValue < m_ctCount);
+      ASSERT(val.GetType() == m_eType);
+
+      switch (m_eType) {
+        case CAnyValue::E_VAL_BOOL:   SetAs<CAnyValue::Bool_t  >(iValue, val); break;
+        case CAnyValue::E_VAL_INDEX:  SetAs<CAnyValue::Int_t   >(iValue, val); break;
+        case CAnyValue::E_VAL_FLOAT:  SetAs<CAnyValue::Float_t >(iValue, val); break;
+        case CAnyValue::E_VAL_DOUBLE: SetAs<CAnyValue::Double_t>(iValue, val); break;
+        case CAnyValue::E_VAL_STRING: SetAs<CAnyValue::String_t>(iValue, val); break;
+        case CAnyValue::E_VAL_PTR:    SetAs<CAnyValue::Ptr_t   >(iValue, val); break;
+        case CAnyValue::E_VAL_VECTOR: SetAs<CAnyValue::Vector_t>(iValue, val); break;
+        case CAnyValue::E_VAL_PLANE:  SetAs<CAnyValue::Plane_t >(iValue, val); break;
+        case CAnyValue::E_VAL_PLACE:  SetAs<CAnyValue::Place_t >(iValue, val); break;
+        case CAnyValue::E_VAL_BOX:    SetAs<CAnyValue::Box_t   >(iValue, val); break;
+        case CAnyValue::E_VAL_QUAT:   SetAs<CAnyValue::Quat_t  >(iValue, val); break;
+        case CAnyValue::E_VAL_MATRIX: SetAs<CAnyValue::Matrix_t>(iValue, val); break;
+        default: ASSERTALWAYS("Unknown value type in CAnyValueArray::Set()");
+      }
+    };
+
+  // Typed spans of all values
+  public:
+
+    inline se1::span<INDEX> GetIndices(void) {
+      ASSERT(m_eType == CAnyValue::E_VAL_BOOL || m_eType == CAnyValue::E_VAL_INDEX);
+      return se1::span<INDEX>(Values<CAnyValue::Int_t>(), m_ctCount);
+    };
+
+    inline se1::span<FLOAT>    GetFloats(void)  { return Span<CAnyValue::Float_t >(); };
+    inline se1::span<DOUBLE>   GetDoubles(void) { return Span<CAnyValue::Double_t>(); };
+    inline se1::span<CTString> GetStrings(void) { return Span<CAnyValue::String_t>(); };
+    inline se1::span<void *>   GetPtrs(void)    { return Span<CAnyValue::Ptr_t   >(); };
+
+    // Get one component of all spatial values (e.g. column 1 of vectors is Y and column 3 of planes is the distance)
+    inline se1::span<FLOAT> GetColumn(INDEX iComponent) {
+      ASSERT(iComponent >= 0 && iComponent < CountColumns());
+      return se1::span<FLOAT>(Column(iComponent), m_ctCount);
+    };
+
+  // Bulk value converters that write all values into an array of Count() elements
+  // Conversions are the same as in CAnyValue
+  public:
+
+    void ToFloat(DOUBLE *aOut) const {
+      switch (m_eType) {
+        // Any non-zero value is true
+        case CAnyValue::E_VAL_BOOL: {
+          const INDEX *ai = Values<CAnyValue::Bool_t>();
+          for (INDEX i = 0; i < m_ctCount; i++) aOut[i] = (ai[i] != 0);
+        } return;
+
+        case CAnyValue::E_VAL_INDEX: {
+          const INDEX *ai = Values<CAnyValue::Int_t>();
+          for (INDEX i = 0; i < m_ctCount; i++) aOut[i] = ai[i];
+        } return;
+
+        case CAnyValue::E_VAL_FLOAT: {
+          const FLOAT *af = Values<CAnyValue::Float_t>();
+          for (INDEX i = 0; i < m_ctCount; i++) aOut[i] = af[i];
+        } return;
+
+        case CAnyValue::E_VAL_DOUBLE: {
+          memcpy(aOut, m_pData, m_ctCount * sizeof(DOUBLE));
+        } return;
+      }
+
+      ASSERTALWAYS("Unknown value type in CAnyValueArray::ToFloat()");
+      for (INDEX i = 0; i < m_ctCount; i++) aOut[i] = 0.0;
+    };
+
+    void ToVector(FLOAT3D *aOut) const {
+      switch (m_eType) {
+        // Vectors, plane normals and placement positions are all in the first three columns
+        case CAnyValue::E_VAL_VECTOR:
+        case CAnyValue::E_VAL_PLANE:
+        case CAnyValue::E_VAL_PLACE: {
+          const FLOAT *afX = Column(0);
+          const FLOAT *afY = Column(1);
+          const FLOAT *afZ = Column(2);
+          for (INDEX i = 0; i < m_ctCount; i++) aOut[i] = FLOAT3D(afX[i], afY[i], afZ[i]);
+        } return;
+
+        // Matrices to rotation angles
+        case CAnyValue::E_VAL_MATRIX: {
+          FLOATmatrix3D m;
+
+          for (INDEX i = 0; i < m_ctCount; i++) {
+            LoadElement(i, (FLOAT *)&m);
+            DecomposeRotationMatrixNoSnap(aOut[i], m);
+          }
+        } return;
+      }
+
+      ASSERTALWAYS("Unknown value type in CAnyValueArray::ToVector()");
+      for (INDEX i = 0; i < m_ctCount; i++) aOut[i] = FLOAT3D(0, 0, 0);
+    };
+
+    void ToMatrix(FLOATmatrix3D *aOut) const {
+      switch (m_eType) {
+        // Rotation angles to matrices (placement angles follow the position)
+        case CAnyValue::E_VAL_VECTOR:
+        case CAnyValue::E_VAL_PLACE: {
+          const INDEX iFirst = (m_eType == CAnyValue::E_VAL_PLACE ? 3 : 0);
+          const FLOAT *afH = Column(iFirst + 0);
+          const FLOAT *afP = Column(iFirst + 1);
+          const FLOAT *afB = Column(iFirst + 2);
+          for (INDEX i = 0; i < m_ctCount; i++) MakeRotationMatrix(aOut[i], ANGLE3D(afH[i], afP[i], afB[i]));
+        } return;
+
+        // Quaternion conversion
+        case CAnyValue::E_VAL_QUAT: {
+          const FLOAT *afW = Column(0);
+          const FLOAT *afX = Column(1);
+          const FLOAT *afY = Column(2);
+          const FLOAT *afZ = Column(3);
+          for (INDEX i = 0; i < m_ctCount; i++) FLOATquat3D(afW[i], afX[i], afY[i], afZ[i]).ToMatrix(aOut[i]);
+        } return;
+
+        case CAnyValue::E_VAL_MATRIX: {
+          for (INDEX iComponent = 0; iComponent < 9; iComponent++) {
+            const FLOAT *af = Column(iComponent);
+            for (INDEX i = 0; i < m_ctCount; i++) ((FLOAT *)&aOut[i])[iComponent] = af[i];
+          }
+        } return;
+      }
+
+      ASSERTALWAYS("Unknown value type in CAnyValueArray::ToMatrix()");
+      for (INDEX i = 0; i < m_ctCount; i++) aOut[i] = FLOATmatrix3D(0);
+    };
+
+  // Binary serialization in the same format as CAnyValue
+  // The type is only written once, followed by the amount of values and the values themselves
+  public:
+
+    void Write_t(CTStream &strm) const {
+      const UBYTE ubType = (UBYTE)m_eType;
+      strm.Write_t(&ubType, 1);
+      CAnyValue::WriteVarint_t(strm, (ULONG)m_ctCount);
+
+      if (m_ctCount == 0) return;
+
+      // Gather spatial values in batches and write them whole
+      if (IsSpatial(m_eType)) {
+        FLOAT aBatch[64 * 9];
+        const INDEX ctColumns = CountColumns();
+        const INDEX ctBatch = INDEX(sizeof(aBatch) / sizeof(FLOAT)) / ctColumns;
+
+        for (INDEX iFirst = 0; iFirst < m_ctCount; iFirst += ctBatch) {
+          const INDEX ct = ClampUp(m_ctCount - iFirst, ctBatch);
+          for (INDEX i = 0; i < ct; i++) LoadElement(iFirst + i, aBatch + i * ctColumns);
+
+          strm.Write_t(aBatch, ct * m_ctElementSize);
+        }
+        return;
+      }
+
+      // Write all values at once
+      if (CAnyValue::IsRawValue(m_eType)) {
+        strm.Write_t(m_pData, m_ctCount * m_ctElementSize);
+        return;
+      }
+
+      for (INDEX i = 0; i < m_ctCount; i++) {
+        CAnyValue::WriteValue_t(strm, m_eType, m_pData + i * m_ctElementSize);
+      }
+    };
+
+    void Read_t(CTStream &strm) {
+      UBYTE ubType;
+      strm.Read_t(&ubType, 1);
+
+      const EType eType = (EType)ubType;
+      const INDEX ct = (INDEX)CAnyValue::ReadCount_t(strm);
+
+      if (eType == CAnyValue::E_VAL_NULL ? ct != 0 : CAnyValue::ValueSize(eType) == 0) {
+        ThrowF_t((char *)TRANSV("Unknown value type %d"), ubType);
+      }
+
+      SetType(eType);
+      if (ct == 0) return;
+
+      Resize(ct);
+
+      // Read whole spatial values in batches and scatter them into columns
+      if (IsSpatial(m_eType)) {
+        FLOAT aBatch[64 * 9];
+        const INDEX ctColumns = CountColumns();
+        const INDEX ctBatch = INDEX(sizeof(aBatch) / sizeof(FLOAT)) / ctColumns;
+
+        for (INDEX iFirst = 0; iFirst < ct; iFirst += ctBatch) {
+          const INDEX ctRead = ClampUp(ct - iFirst, ctBatch);
+          strm.Read_t(aBatch, ctRead * m_ctElementSize);
+
+          for (INDEX i = 0; i < ctRead; i++) StoreElement(iFirst + i, aBatch + i * ctColumns);
+        }
+        return;
+      }
+
+      // Read all values at once
+      if (CAnyValue::IsRawValue(m_eType)) {
+        strm.Read_t(m_pData, ct * m_ctElementSize);
+        return;
+      }
+
+      for (INDEX i = 0; i < ct; i++) {
+        CAnyValue::ReadValue_t(strm, m_eType, m_pData + i * m_ctElementSize);
+      }
+    };
+};
+
+#endif
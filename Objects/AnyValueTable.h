@@ -0,0 +1,105 @@
+/* Copyright (c) 2026 Dreamy Cecil
+This program is free software; you can redistribute it and/or modify
+it under the terms of version 2 of the GNU General Public License as published by
+the Free Software Foundation
+
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License along
+with this program; if not, write to the Free Software Foundation, Inc.,
+51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA. */
+
+#ifndef XGIZMO_INCL_ANYVALUETABLE_H
+#define XGIZMO_INCL_ANYVALUETABLE_H
+
+#ifdef PRAGMA_ONCE
+  #pragma once
+#endif
+
+#include "AnyValue.h"
+
+// Table of unique values for interning repeated constants
+// Each value is stored once and shared, so copies of interned strings and big values reference the same holder.
+// NOTE: Reference counting of shared values isn't thread-safe, so the table should only be used from one thread!
+class CAnyValueTable {
+  public:
+    // Unique values and how many times each of them has been interned
+    typedef se1::map<CAnyValue, ULONG> Values;
+
+  private:
+    Values m_mapValues;
+
+  private:
+    // Cannot be copied
+    CAnyValueTable(const CAnyValueTable &);
+    void operator=(const CAnyValueTable &);
+
+  public:
+    // Default constructor
+    CAnyValueTable() {};
+
+    // Get unique instance of some value, adding it to the table if there's none
+    const CAnyValue &Intern(const CAnyValue &val) {
+      Values::iterator it = m_mapValues.find(val);
+
+      if (it == m_mapValues.end()) {
+        CAnyValue valShared(val);
+        valShared.MakeShared();
+
+        it = m_mapValues.insert(Values::value_type(valShared, 0)).first;
+      }
+
+      it->second++;
+      return it->first;
+    };
+
+    // Find unique instance of some value (returns NULL if it hasn't been interned)
+    const CAnyValue *Find(const CAnyValue &val) const {
+      Values::const_iterator it = m_mapValues.find(val);
+      return (it != m_mapValues.end()) ? &it->first : NULL;
+    };
+
+    // Check if some value has been interned
+    inline bool Contains(const CAnyValue &val) const {
+      return Find(val) != NULL;
+    };
+
+    // Count unique values
+    inline INDEX Count(void) const {
+      return (INDEX)m_mapValues.size();
+    };
+
+    // Get unique values
+    inline const Values &GetMap(void) const {
+      return m_mapValues;
+    };
+
+    // Remove all values
+    void Clear(void) {
+      m_mapValues.clear();
+    };
+
+    // Remove shared values that aren't referenced outside the table anymore and return how many have been removed
+    // Small values aren't shared, so they are always kept.
+    INDEX Prune(void) {
+      INDEX ctRemoved = 0;
+      Values::iterator it = m_mapValues.begin();
+
+      while (it != m_mapValues.end()) {
+        if (it->first.IsShared() && it->first.CountRefs() == 1) {
+          it = m_mapValues.erase(it);
+          ctRemoved++;
+        } else {
+          it++;
+        }
+      }
+
+      return ctRemoved;
+    };
+};
+
+#endif
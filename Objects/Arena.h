@@ -0,0 +1,343 @@
+/* Copyright (c) 2026 Dreamy Cecil
+This program is free software; you can redistribute it and/or modify
+it under the terms of version 2 of the GNU General Public License as published by
+the Free Software Foundation
+
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License along
+with this program; if not, write to the Free Software Foundation, Inc.,
+51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA. */
+
+#ifndef XGIZMO_INCL_ARENA_H
+#define XGIZMO_INCL_ARENA_H
+
+#ifdef PRAGMA_ONCE
+  #pragma once
+#endif
+
+// Placement new is used by the allocator, so 'new' must stay undefined in debug until the end of this file
+#include "../Base/STLIncludesBegin.h"
+#include <new>
+#include <stddef.h>
+#include <stdlib.h>
+
+namespace se1 {
+
+// Bump allocator that hands out memory from large blocks and releases all of it at once
+// Individual allocations are never freed, so it suits data that is built once and then discarded as a whole
+class arena {
+  private:
+    // Block of memory with its header in front of it
+    struct Block {
+      Block *pNext; // Previously allocated block
+      size_t ctSize; // Usable size of this block
+      size_t ctUsed; // Already allocated bytes
+    };
+
+    // Alignment of all allocations
+    enum { _ALIGN = sizeof(void *) * 2 };
+
+    Block *_pBlocks; // Block that memory is currently allocated from
+    size_t _ctBlockSize; // Default size of new blocks
+    size_t _ctAllocated; // Total size of all blocks
+
+    // Cannot be copied
+    arena(const arena &);
+    void operator=(const arena &);
+
+  private:
+    // Round size up to the alignment
+    static __forceinline size_t Align(size_t ct) {
+      return (ct + _ALIGN - 1) & ~size_t(_ALIGN - 1);
+    };
+
+    // Memory after the block header
+    static __forceinline char *Data(Block *pBlock) {
+      return (char *)pBlock + Align(sizeof(Block));
+    };
+
+    // Add a new block that fits a certain amount of bytes
+    Block *AddBlock(size_t ctMin) {
+      const size_t ctSize = (ctMin > _ctBlockSize) ? ctMin : _ctBlockSize;
+
+      Block *pBlock = (Block *)malloc(Align(sizeof(Block)) + ctSize);
+      if (pBlock == NULL) throw std::bad_alloc();
+
+      pBlock->ctSize = ctSize;
+      pBlock->ctUsed = 0;
+      _ctAllocated += ctSize;
+
+      // Oversized blocks go behind the current one to keep allocating from it
+      if (_pBlocks != NULL && ctSize > _ctBlockSize) {
+        pBlock->pNext = _pBlocks->pNext;
+        _pBlocks->pNext = pBlock;
+
+      } else {
+        pBlock->pNext = _pBlocks;
+        _pBlocks = pBlock;
+      }
+
+      return pBlock;
+    };
+
+  public:
+    // Constructor with a default size of new blocks
+    arena(size_t ctBlockSize = 64 * 1024) : _pBlocks(NULL), _ctBlockSize(ctBlockSize), _ctAllocated(0)
+    {
+    };
+
+    // Free all blocks on destruction
+    ~arena() {
+      release();
+    };
+
+    // Allocate some memory that lives until the arena is reset or released
+    void *allocate(size_t ct) {
+      ct = Align(ct);
+      Block *pBlock = _pBlocks;
+
+      if (pBlock == NULL || pBlock->ctSize - pBlock->ctUsed < ct) {
+        pBlock = AddBlock(ct);
+      }
+
+      void *pMemory = Data(pBlock) + pBlock->ctUsed;
+      pBlock->ctUsed += ct;
+      return pMemory;
+    };
+
+    // Discard all allocations but keep the current block for reuse
+    void reset(void) {
+      if (_pBlocks == NULL) return;
+
+      Block *pKeep = _pBlocks;
+      _pBlocks = pKeep->pNext;
+      release();
+
+      pKeep->pNext = NULL;
+      pKeep->ctUsed = 0;
+      _pBlocks = pKeep;
+      _ctAllocated = pKeep->ctSize;
+    };
+
+    // Free all blocks
+    void release(void) {
+      while (_pBlocks != NULL) {
+        Block *pNext = _pBlocks->pNext;
+        free(_pBlocks);
+        _pBlocks = pNext;
+      }
+
+      _ctAllocated = 0;
+    };
+
+    // Get default size of new blocks
+    inline size_t block_size(void) const {
+      return _ctBlockSize;
+    };
+
+    // Get total size of all blocks
+    inline size_t allocated(void) const {
+      return _ctAllocated;
+    };
+};
+
+// STL allocator that takes memory from an arena or from the heap, if there's no arena
+// Memory is never returned to the arena, so containers that use it should be discarded before resetting it
+template<class Type>
+class arena_allocator {
+  public:
+    typedef Type value_type;
+    typedef Type *pointer;
+    typedef const Type *const_pointer;
+    typedef Type &reference;
+    typedef const Type &const_reference;
+    typedef size_t size_type;
+    typedef ptrdiff_t difference_type;
+
+    template<class Other>
+    struct rebind {
+      typedef arena_allocator<Other> other;
+    };
+
+    arena *_pArena; // Arena to allocate from (NULL for the heap)
+
+  public:
+    // Constructor with an arena
+    arena_allocator(arena *pArena = NULL) : _pArena(pArena) {};
+
+    // Conversion from an allocator of another type
+    template<class Other>
+    arena_allocator(const arena_allocator<Other> &other) : _pArena(other._pArena) {};
+
+    pointer address(reference val) const { return &val; };
+    const_pointer address(const_reference val) const { return &val; };
+
+    // Allocate memory for some amount of elements
+    pointer allocate(size_type ct, const void * = NULL) {
+      const size_t ctBytes = ct * sizeof(Type);
+
+      if (_pArena != NULL) {
+        return (pointer)_pArena->allocate(ctBytes);
+      }
+
+      return (pointer)::operator new(ctBytes);
+    };
+
+    // Free memory of some elements (only on the heap)
+    void deallocate(pointer p, size_type) {
+      if (_pArena == NULL) {
+        ::operator delete(p);
+      }
+    };
+
+    size_type max_size() const { return size_t(-1) / sizeof(Type); };
+
+    void construct(pointer p, const Type &val) { new ((void *)p) Type(val); };
+    void destroy(pointer p) { p->~Type(); };
+};
+
+template<class Type1, class Type2> inline
+bool operator==(const arena_allocator<Type1> &al1, const arena_allocator<Type2> &al2) {
+  return al1._pArena == al2._pArena;
+};
+
+template<class Type1, class Type2> inline
+bool operator!=(const arena_allocator<Type1> &al1, const arena_allocator<Type2> &al2) {
+  return al1._pArena != al2._pArena;
+};
+
+// Allocator of fixed-size chunks that keeps freed chunks in a list and reuses them before taking new ones
+// Chunks are taken from slabs that are only freed together with the pool, so the memory usage never goes below the peak
+// NOTE: Not thread-safe!
+class pool {
+  private:
+    // Freed chunk
+    struct Chunk {
+      Chunk *pNext;
+    };
+
+    // Slab of chunks with its header in front of it
+    struct Slab {
+      Slab *pNext;
+    };
+
+    enum { _ALIGN = sizeof(void *) * 2 };
+
+    size_t _ctChunkSize; // Size of each chunk
+    size_t _ctSlabChunks; // Amount of chunks in each slab
+
+    Slab *_pSlabs; // All allocated slabs
+    Chunk *_pFree; // Chunks that can be reused
+    char *_pchFresh; // Chunks in the last slab that have never been used
+    size_t _ctFresh;
+
+    size_t _ctLive; // Chunks that are currently in use
+    size_t _ctPeak; // Most chunks that have been in use at the same time
+    size_t _ctHits; // Allocations that have reused freed chunks
+    size_t _ctSlabs; // Amount of allocated slabs
+
+    // Cannot be copied
+    pool(const pool &);
+    void operator=(const pool &);
+
+  private:
+    // Round size up to the alignment
+    static __forceinline size_t Align(size_t ct) {
+      return (ct + _ALIGN - 1) & ~size_t(_ALIGN - 1);
+    };
+
+    // Allocate a new slab of fresh chunks
+    void AddSlab(void) {
+      Slab *pSlab = (Slab *)malloc(Align(sizeof(Slab)) + _ctChunkSize * _ctSlabChunks);
+      if (pSlab == NULL) throw std::bad_alloc();
+
+      pSlab->pNext = _pSlabs;
+      _pSlabs = pSlab;
+      _ctSlabs++;
+
+      _pchFresh = (char *)pSlab + Align(sizeof(Slab));
+      _ctFresh = _ctSlabChunks;
+    };
+
+  public:
+    // Constructor with a size of each chunk and an amount of chunks to allocate at once
+    pool(size_t ctChunkSize, size_t ctSlabChunks = 64) :
+      _ctChunkSize(Align(ctChunkSize > sizeof(Chunk) ? ctChunkSize : sizeof(Chunk))), _ctSlabChunks(ctSlabChunks),
+      _pSlabs(NULL), _pFree(NULL), _pchFresh(NULL), _ctFresh(0), _ctLive(0), _ctPeak(0), _ctHits(0), _ctSlabs(0)
+    {
+      ASSERT(ctSlabChunks > 0);
+    };
+
+    // Free all slabs on destruction
+    ~pool() {
+      // Keep memory of chunks that are still in use (e.g. by static objects that are destroyed later)
+      if (_ctLive != 0) return;
+
+      while (_pSlabs != NULL) {
+        Slab *pNext = _pSlabs->pNext;
+        free(_pSlabs);
+        _pSlabs = pNext;
+      }
+    };
+
+    // Allocate one chunk
+    void *allocate(void) {
+      void *pChunk;
+
+      if (_pFree != NULL) {
+        pChunk = _pFree;
+        _pFree = _pFree->pNext;
+        _ctHits++;
+
+      } else {
+        if (_ctFresh == 0) AddSlab();
+
+        pChunk = _pchFresh;
+        _pchFresh += _ctChunkSize;
+        _ctFresh--;
+      }
+
+      if (++_ctLive > _ctPeak) _ctPeak = _ctLive;
+      return pChunk;
+    };
+
+    // Return a chunk for reuse
+    void deallocate(void *p) {
+      if (p == NULL) return;
+      ASSERT(_ctLive > 0);
+
+      Chunk *pChunk = (Chunk *)p;
+      pChunk->pNext = _pFree;
+      _pFree = pChunk;
+      _ctLive--;
+    };
+
+    // Get size of each chunk
+    inline size_t chunk_size(void) const { return _ctChunkSize; };
+
+    // Get amount of chunks that are currently in use
+    inline size_t live(void) const { return _ctLive; };
+
+    // Get the most chunks that have been in use at the same time
+    inline size_t peak(void) const { return _ctPeak; };
+
+    // Get amount of allocations that have reused freed chunks
+    inline size_t hits(void) const { return _ctHits; };
+
+    // Get amount of allocated slabs
+    inline size_t slabs(void) const { return _ctSlabs; };
+
+    // Get total size of all slabs
+    inline size_t allocated(void) const { return _ctSlabs * _ctSlabChunks * _ctChunkSize; };
+};
+
+}; // namespace
+
+#include "../Base/STLIncludesEnd.h"
+
+#endif
@@ -22,45 +22,604 @@ with this program; if not, write to the Free Software Foundation, Inc.,
 
 #include "../Base/STLIncludesBegin.h"
 #include <list>
+#include <vector>
+#include <string>
 #include <stdexcept>
+#include <functional>
+#include <ctype.h>
+#include <string.h>
 #include "../Base/STLIncludesEnd.h"
 
+// Engine strings that may be used as keys
+class CTString;
+class CTFileName;
+
 namespace se1 {
 
-// Slow but stable and limited reimplementation of 'std::map'
-// The internal mechanism of 'std::map' works with defects in C++98
-template<class _T1, class _T2>
-class map : public std::list<std::pair<_T1, _T2> > {
+// FNV-1a hash of a character range
+inline size_t HashChars(const char *pch, size_t ct) {
+  size_t iHash = 2166136261U;
+
+  for (; ct != 0; --ct, ++pch) {
+    iHash = (iHash ^ (unsigned char)*pch) * 16777619U;
+  }
+
+  return iHash;
+};
+
+// FNV-1a hash of a case-insensitive null-terminated string
+inline size_t HashCharsNoCase(const char *pch) {
+  size_t iHash = 2166136261U;
+
+  for (; *pch != '\0'; ++pch) {
+    iHash = (iHash ^ (unsigned char)tolower((unsigned char)*pch)) * 16777619U;
+  }
+
+  return iHash;
+};
+
+// Tag of hash functions that can't hash their keys
+struct map_hash_none {};
+
+// Hash function for map keys
+// Specialize it for custom key types that are compared using 'operator=='
+// Keys without a specialization aren't hashed and are always searched through linearly
+template<class Type>
+struct map_hash : public map_hash_none {
+  size_t operator()(const Type &) const { return 0; };
+};
+
+// Check whether some hash function can actually hash its keys
+template<class _Hash>
+struct map_hash_used {
+  static char Test(const map_hash_none *);
+  static int Test(...);
+
+  enum { value = (sizeof(Test((const _Hash *)0)) != sizeof(char)) };
+};
+
+// Integral keys are their own hash
+#define XGIZMO_MAP_HASH_INTEGRAL(_Type) \
+  template<> struct map_hash<_Type> { \
+    size_t operator()(_Type key) const { return (size_t)key; }; \
+  };
+
+XGIZMO_MAP_HASH_INTEGRAL(bool)
+XGIZMO_MAP_HASH_INTEGRAL(char)
+XGIZMO_MAP_HASH_INTEGRAL(signed char)
+XGIZMO_MAP_HASH_INTEGRAL(unsigned char)
+XGIZMO_MAP_HASH_INTEGRAL(signed short)
+XGIZMO_MAP_HASH_INTEGRAL(unsigned short)
+XGIZMO_MAP_HASH_INTEGRAL(signed int)
+XGIZMO_MAP_HASH_INTEGRAL(unsigned int)
+XGIZMO_MAP_HASH_INTEGRAL(signed long)
+XGIZMO_MAP_HASH_INTEGRAL(unsigned long)
+
+#undef XGIZMO_MAP_HASH_INTEGRAL
+
+// 64-bit integers are folded into one half
+template<>
+struct map_hash<__int64> {
+  size_t operator()(__int64 key) const { return (size_t)(key ^ (key >> 32)); };
+};
+
+template<>
+struct map_hash<unsigned __int64> {
+  size_t operator()(unsigned __int64 key) const { return (size_t)(key ^ (key >> 32)); };
+};
+
+// Floating point keys are hashed by their bits (both zeros are equal, so they must have the same hash)
+template<>
+struct map_hash<float> {
+  size_t operator()(float key) const {
+    if (key == 0.0f) return 0;
+
+    unsigned int iBits;
+    memcpy(&iBits, &key, sizeof(iBits));
+    return iBits;
+  };
+};
+
+template<>
+struct map_hash<double> {
+  size_t operator()(double key) const {
+    if (key == 0.0) return 0;
+
+    unsigned int aBits[2];
+    memcpy(aBits, &key, sizeof(aBits));
+    return aBits[0] ^ aBits[1];
+  };
+};
+
+// Pointers are hashed by their address
+template<class Type>
+struct map_hash<Type *> {
+  size_t operator()(const Type *key) const { return (size_t)key; };
+};
+
+// STL strings are compared by their exact contents
+template<>
+struct map_hash<std::string> {
+  size_t operator()(const std::string &key) const { return HashChars(key.c_str(), key.length()); };
+};
+
+// Engine strings are compared without case sensitivity
+// The string classes may not be defined yet, so their hash functions are instantiated only when they are used
+template<>
+struct map_hash<CTString> {
+  template<class Type> size_t operator()(const Type &key) const { return HashCharsNoCase(key.str_String); };
+};
+
+template<>
+struct map_hash<CTFileName> {
+  template<class Type> size_t operator()(const Type &key) const { return HashCharsNoCase(key.str_String); };
+};
+
+// Insertion-ordered associative container with hashed lookup
+// The internal mechanism of 'std::map' works with defects in C++98, so pairs are kept in a plain list in the order of insertion
+// and once there are enough of them, an open addressing table of list iterators is built on top for O(1) lookups.
+// The whole 'std::list' interface is available as well and it keeps the table up to date. List methods don't check keys,
+// so they may add pairs under keys that already exist, in which case only the first pair under each key can be found.
+// NOTE: Keys must not be modified through iterators, otherwise they won't be found anymore!
+template<class _T1, class _T2, class _Hash = map_hash<_T1>, class _Alloc = std::allocator<std::pair<_T1, _T2> > >
+class map {
   public:
     typedef std::pair<_T1, _T2> value_type;
-    typedef std::list<value_type> _Myt;
+    typedef _T1 key_type;
+    typedef _T2 mapped_type;
+    typedef _Alloc allocator_type;
+    typedef std::list<value_type, _Alloc> _Myt;
+
+    typedef typename _Myt::iterator iterator;
+    typedef typename _Myt::const_iterator const_iterator;
+    typedef typename _Myt::reverse_iterator reverse_iterator;
+    typedef typename _Myt::const_reverse_iterator const_reverse_iterator;
+    typedef typename _Myt::reference reference;
+    typedef typename _Myt::const_reference const_reference;
+    typedef typename _Myt::size_type size_type;
+    typedef typename _Myt::difference_type difference_type;
+
     typedef std::pair<iterator, bool> _Pairib;
 
+  private:
+    // Amount of pairs that are searched through linearly before building a table
+    enum { _SMALL_SIZE = 8 };
+
+    // Whether keys can be hashed at all
+    enum { _HASHED = map_hash_used<_Hash>::value };
+
+    // Table slot that references a pair in the list
+    struct _Slot {
+      iterator it;
+      size_t iHash;
+      bool bUsed;
+
+      _Slot() : iHash(0), bUsed(false) {};
+    };
+
+    typedef typename _Alloc::template rebind<_Slot>::other _SlotAlloc;
+
+    _Myt _list; // Pairs in the order of insertion
+    std::vector<_Slot, _SlotAlloc> _aSlots; // Lookup table (power of two size or empty for small maps)
+    bool _bDupes; // Some keys in the table have more than one pair in the list
+
+  public:
+    // Default constructor
+    map() : _bDupes(false) {};
+
+    // Constructor with a specific allocator for pairs and the table
+    explicit map(const _Alloc &al) : _list(al), _aSlots(_SlotAlloc(al)), _bDupes(false) {};
+
+    // Copy constructor (uses the same allocator as the other map)
+    map(const map &other) : _list(other._list), _aSlots(_SlotAlloc(other._list.get_allocator())), _bDupes(false) {
+      Rehash();
+    };
+
+    // Assignment
+    map &operator=(const map &other) {
+      if (this != &other) {
+        _list = other._list;
+        Rehash();
+      }
+      return *this;
+    };
+
+  private:
+    // Mix bits of the key hash to spread sequential values across the table
+    static __forceinline size_t MixHash(size_t iHash) {
+      iHash ^= iHash >> 16;
+      iHash *= 0x45D9F3BU;
+      iHash ^= iHash >> 16;
+      return iHash;
+    };
+
+    // Find table slot of a specific key or the first empty slot where it should be
+    size_t FindSlot(const _T1 &key, size_t iHash) const {
+      const size_t iMask = _aSlots.size() - 1;
+      size_t iSlot = iHash & iMask;
+
+      for (;;) {
+        const _Slot &slot = _aSlots[iSlot];
+        if (!slot.bUsed) return iSlot;
+
+        if (slot.iHash == iHash && slot.it->first == key) return iSlot;
+        iSlot = (iSlot + 1) & iMask;
+      }
+    };
+
+    // Remove a slot from the table and shift subsequent slots back into the gap
+    void RemoveSlot(size_t iSlot) {
+      const size_t iMask = _aSlots.size() - 1;
+      size_t iNext = iSlot;
+
+      for (;;) {
+        _aSlots[iSlot].bUsed = false;
+
+        for (;;) {
+          iNext = (iNext + 1) & iMask;
+          const _Slot &slot = _aSlots[iNext];
+          if (!slot.bUsed) return;
+
+          // Move it back if its ideal position isn't cyclically between the gap and itself
+          const size_t iIdeal = slot.iHash & iMask;
+
+          if (iSlot <= iNext ? (iSlot >= iIdeal || iIdeal > iNext) : (iSlot >= iIdeal && iIdeal > iNext)) {
+            break;
+          }
+        }
+
+        _aSlots[iSlot] = _aSlots[iNext];
+        iSlot = iNext;
+      }
+    };
+
+    // Rebuild the table for the current amount of pairs
+    void Rehash(void) {
+      _aSlots.clear();
+      _bDupes = false;
+
+      const size_t ct = _list.size();
+      if (!_HASHED || ct <= _SMALL_SIZE) return;
+
+      // Keep the load factor at or below 50%
+      size_t ctSlots = 16;
+      while (ctSlots < ct * 2) ctSlots <<= 1;
+
+      // Empty slots reference the end of the list instead of staying uninitialized
+      _Slot slotEmpty;
+      slotEmpty.it = _list.end();
+      _aSlots.resize(ctSlots, slotEmpty);
+
+      for (iterator it = _list.begin(); it != _list.end(); ++it) {
+        const size_t iHash = MixHash(_Hash()(it->first));
+        _Slot &slot = _aSlots[FindSlot(it->first, iHash)];
+
+        // Only the first pair under each key is put into the table
+        if (slot.bUsed) {
+          _bDupes = true;
+          continue;
+        }
+
+        slot.it = it;
+        slot.iHash = iHash;
+        slot.bUsed = true;
+      }
+    };
+
+    // Put a pair that has just been added to the list into the table
+    void IndexPair(iterator it, bool bLast) {
+      if (!_HASHED) return;
+
+      // Keep searching linearly until there are enough pairs
+      // The table is kept once it's been built, even if pairs are erased afterwards
+      const size_t ct = _list.size();
+
+      if (_aSlots.empty()) {
+        if (ct > _SMALL_SIZE) Rehash();
+        return;
+      }
+
+      // Grow the table past 50% load
+      if (ct * 2 > _aSlots.size()) {
+        Rehash();
+        return;
+      }
+
+      const size_t iHash = MixHash(_Hash()(it->first));
+      _Slot &slot = _aSlots[FindSlot(it->first, iHash)];
+
+      if (!slot.bUsed) {
+        slot.it = it;
+        slot.iHash = iHash;
+        slot.bUsed = true;
+        return;
+      }
+
+      if (slot.it == it) return;
+      _bDupes = true;
+
+      // The new pair may be before the one in the table now
+      if (!bLast) Rehash();
+    };
+
+    // Remove a pair that's about to be removed from the list from the table
+    // Returns true if the table needs to be rebuilt afterwards for another pair under the same key
+    bool UnindexPair(iterator it) {
+      if (_aSlots.empty()) return false;
+
+      const size_t iSlot = FindSlot(it->first, MixHash(_Hash()(it->first)));
+      const _Slot &slot = _aSlots[iSlot];
+
+      // Not in the table because it's a duplicate
+      if (!slot.bUsed || slot.it != it) return false;
+
+      RemoveSlot(iSlot);
+      return _bDupes;
+    };
+
+    // Find a key by going through the list
+    iterator FindLinear(const _T1 &key) const {
+      _Myt &list = const_cast<_Myt &>(_list);
+      iterator it = list.begin();
+
+      for (; it != list.end(); ++it) {
+        if (it->first == key) break;
+      }
+
+      return it;
+    };
+
+    // Find a key in the table or the list
+    iterator FindKey(const _T1 &key) const {
+      if (_aSlots.empty()) return FindLinear(key);
+
+      const _Slot &slot = _aSlots[FindSlot(key, MixHash(_Hash()(key)))];
+      if (slot.bUsed) return slot.it;
+
+      return const_cast<_Myt &>(_list).end();
+    };
+
+  // List interface
+  public:
+
+    iterator begin() { return _list.begin(); };
+    const_iterator begin() const { return _list.begin(); };
+    iterator end() { return _list.end(); };
+    const_iterator end() const { return _list.end(); };
+
+    reverse_iterator rbegin() { return _list.rbegin(); };
+    const_reverse_iterator rbegin() const { return _list.rbegin(); };
+    reverse_iterator rend() { return _list.rend(); };
+    const_reverse_iterator rend() const { return _list.rend(); };
+
+    reference front() { return _list.front(); };
+    const_reference front() const { return _list.front(); };
+    reference back() { return _list.back(); };
+    const_reference back() const { return _list.back(); };
+
+    inline size_type size() const { return _list.size(); };
+    inline size_type max_size() const { return _list.max_size(); };
+    inline bool empty() const { return _list.empty(); };
+
+    inline allocator_type get_allocator() const { return _list.get_allocator(); };
+
+    // Insert a pair before some position
+    iterator insert(iterator itWhere, const value_type &pair) {
+      iterator it = _list.insert(itWhere, pair);
+      IndexPair(it, itWhere == _list.end());
+      return it;
+    };
+
+    // Insert copies of a pair before some position
+    void insert(iterator itWhere, size_type ct, const value_type &pair) {
+      for (; ct != 0; --ct) insert(itWhere, pair);
+    };
+
+    // Insert a range of pairs before some position
+    template<class _Iter>
+    void insert(iterator itWhere, _Iter itFirst, _Iter itLast) {
+      for (; itFirst != itLast; ++itFirst) insert(itWhere, *itFirst);
+    };
+
+    void push_front(const value_type &pair) { insert(_list.begin(), pair); };
+    void push_back(const value_type &pair) { insert(_list.end(), pair); };
+    void pop_front() { erase(_list.begin()); };
+    void pop_back() { erase(--_list.end()); };
+
+    // Replace all pairs with copies of a pair
+    void assign(size_type ct, const value_type &pair) {
+      const value_type pairCopy(pair);
+      clear();
+      insert(_list.end(), ct, pairCopy);
+    };
+
+    // Replace all pairs with a range of pairs
+    template<class _Iter>
+    void assign(_Iter itFirst, _Iter itLast) {
+      clear();
+      insert(_list.end(), itFirst, itLast);
+    };
+
+    // Change amount of pairs
+    void resize(size_type ct, value_type pair = value_type()) {
+      while (_list.size() > ct) pop_back();
+      insert(_list.end(), ct - _list.size(), pair);
+    };
+
+    // Remove all pairs
+    void clear() {
+      _list.clear();
+      _aSlots.clear();
+      _bDupes = false;
+    };
+
+    // Remove pair at some position
+    iterator erase(iterator it) {
+      const bool bRehash = UnindexPair(it);
+      iterator itNext = _list.erase(it);
+
+      if (bRehash) Rehash();
+      return itNext;
+    };
+
+    // Remove pairs in a range
+    iterator erase(iterator itFirst, iterator itLast) {
+      while (itFirst != itLast) {
+        itFirst = erase(itFirst);
+      }
+      return itLast;
+    };
+
+    // Remove all pairs that are equal to some pair
+    void remove(const value_type &pair) {
+      const value_type pairCopy(pair);
+      iterator it = _list.begin();
+
+      while (it != _list.end()) {
+        if (*it == pairCopy) {
+          it = erase(it);
+        } else {
+          ++it;
+        }
+      }
+    };
+
+    // Remove all pairs that satisfy a predicate
+    template<class _Pred>
+    void remove_if(_Pred pred) {
+      iterator it = _list.begin();
+
+      while (it != _list.end()) {
+        if (pred(*it)) {
+          it = erase(it);
+        } else {
+          ++it;
+        }
+      }
+    };
+
+    // Remove consecutive equal pairs
+    void unique() {
+      unique(std::equal_to<value_type>());
+    };
+
+    // Remove consecutive pairs that satisfy a predicate
+    template<class _Pred>
+    void unique(_Pred pred) {
+      if (_list.empty()) return;
+
+      iterator itPrev = _list.begin();
+      iterator it = itPrev;
+
+      while (++it != _list.end()) {
+        if (pred(*itPrev, *it)) {
+          it = erase(it);
+          --it;
+        } else {
+          itPrev = it;
+        }
+      }
+    };
+
+    // Move all pairs from another map before some position
+    void splice(iterator itWhere, map &other) {
+      if (this == &other) return;
+
+      while (!other.empty()) {
+        splice(itWhere, other, other.begin());
+      }
+    };
+
+    // Move one pair from another map before some position
+    void splice(iterator itWhere, map &other, iterator it) {
+      const bool bRehash = other.UnindexPair(it);
+      _list.splice(itWhere, other._list, it);
+
+      if (bRehash) other.Rehash();
+      IndexPair(it, itWhere == _list.end());
+    };
+
+    // Move a range of pairs from another map before some position
+    void splice(iterator itWhere, map &other, iterator itFirst, iterator itLast) {
+      while (itFirst != itLast) {
+        iterator it = itFirst++;
+        splice(itWhere, other, it);
+      }
+    };
+
+    // Merge pairs from another sorted map into this one
+    void merge(map &other) {
+      if (this == &other) return;
+
+      _list.merge(other._list);
+      other.clear();
+      Rehash();
+    };
+
+    // Merge pairs from another map sorted using a predicate into this one
+    template<class _Pred>
+    void merge(map &other, _Pred pred) {
+      if (this == &other) return;
+
+      _list.merge(other._list, pred);
+      other.clear();
+      Rehash();
+    };
+
+    // Sort pairs (iterators stay valid, so only the first pairs under duplicate keys may change)
+    void sort() {
+      _list.sort();
+      if (_bDupes) Rehash();
+    };
+
+    // Sort pairs using a predicate
+    template<class _Pred>
+    void sort(_Pred pred) {
+      _list.sort(pred);
+      if (_bDupes) Rehash();
+    };
+
+    // Reverse order of pairs
+    void reverse() {
+      _list.reverse();
+      if (_bDupes) Rehash();
+    };
+
+    // Swap contents with another map (both maps must use equal allocators)
+    void swap(map &other) {
+      _list.swap(other._list);
+      _aSlots.swap(other._aSlots);
+      std::swap(_bDupes, other._bDupes);
+    };
+
+    // Compare pairs of two maps in order
+    bool operator==(const map &other) const { return _list == other._list; };
+    bool operator!=(const map &other) const { return _list != other._list; };
+
+  // Map interface
   public:
+
     // Insert a new pair at the end or find an existing one
     _Pairib insert(const value_type &pair) {
       iterator it = find(pair.first);
       if (it != end()) return std::make_pair(it, false);
 
-      return std::make_pair(_Myt::insert(end(), pair), true);
+      return std::make_pair(insert(_list.end(), pair), true);
     };
 
     // Get iterator to a desired key
     iterator find(const _T1 &key) {
-      for (iterator it = begin(); it != end(); it++) {
-        if (it->first == key) return it;
-      }
-
-      return end();
+      return FindKey(key);
     };
 
     // Get constant iterator to a desired key
     const_iterator find(const _T1 &key) const {
-      for (const_iterator it = begin(); it != end(); it++) {
-        if (it->first == key) return it;
-      }
+      return FindKey(key);
+    };
 
-      return end();
+    // Count pairs under some key (either 0 or 1 for pairs added through the map interface)
+    size_type count(const _T1 &key) const {
+      return (FindKey(key) != _list.end()) ? 1 : 0;
     };
 
     // Get pair under some key
@@ -82,7 +641,7 @@ class map : public std::list<std::pair<_T1, _T2> > {
     // Get pair under some key or create it, if there's none
     _T2 &operator[](const _T1 &key) {
       iterator it = find(key);
-      if (it == end()) it = _Myt::insert(end(), value_type(key, _T2()));
+      if (it == end()) it = insert(_list.end(), value_type(key, _T2()));
 
       return it->second;
     };
@@ -20,17 +20,78 @@ with this program; if not, write to the Free Software Foundation, Inc.,
   #pragma once
 #endif
 
+#include "../Base/STLIncludesBegin.h"
+#include <vector>
+#include "../Base/STLIncludesEnd.h"
+
 class CNode {
   private:
+    // Array of child nodes for random access that is rebuilt after the list has changed
+    struct Index {
+      std::vector<CNode *> aNodes;
+      bool bValid;
+
+      Index() : bValid(false) {};
+    };
+
     // List of child nodes (both pointers reference the same node if there's only one)
     CNode *m_pHead;
     CNode *m_pTail;
+    size_t m_ctNodes; // Amount of child nodes in the list
+    Index *m_pIndex; // Index of child nodes (NULL if not indexed)
 
     CNode *m_pParent; // Node that owns this child node in a list (may be NULL)
     CNode *m_pPrev; // Previous neighboring node or NULL if it's the head of the parent
     CNode *m_pNext; // Next neighboring node or NULL if it's the tail of the parent
+    size_t m_iIndex; // Position among children of the parent (only valid while its index is)
 
   private:
+    // Add a new child to the end of a valid index
+    __forceinline void IndexAppend(CNode *pNode) {
+      if (m_pIndex == NULL) return;
+
+      if (m_pIndex->bValid) {
+        pNode->m_iIndex = m_pIndex->aNodes.size();
+        m_pIndex->aNodes.push_back(pNode);
+      }
+    };
+
+    // Remove a child from the index
+    __forceinline void IndexRemove(CNode *pNode) {
+      if (m_pIndex == NULL) return;
+
+      // Only the last child can be removed without rebuilding the index
+      if (m_pIndex->bValid && pNode == m_pTail) {
+        m_pIndex->aNodes.pop_back();
+      } else {
+        m_pIndex->bValid = false;
+      }
+    };
+
+    // Mark the index as outdated after children have been moved
+    __forceinline void IndexInvalidate(void) {
+      if (m_pIndex != NULL) m_pIndex->bValid = false;
+    };
+
+    // Rebuild the index of children, if it's outdated
+    void IndexUpdate(void) const {
+      ASSERT(m_pIndex != NULL);
+      if (m_pIndex->bValid) return;
+
+      std::vector<CNode *> &aNodes = m_pIndex->aNodes;
+      aNodes.resize(m_ctNodes);
+
+      size_t i = 0;
+
+      for (CNode *pCheck = m_pHead; pCheck != NULL; pCheck = pCheck->m_pNext, i++) {
+        pCheck->m_iIndex = i;
+        aNodes[i] = pCheck;
+      }
+
+      ASSERT(i == m_ctNodes);
+      m_pIndex->bValid = true;
+    };
+
     // Setup the very first node in a list
     __forceinline void SetFirstNode(CNode *pFirst) {
       m_pHead = m_pTail = pFirst;
@@ -38,6 +99,10 @@ class CNode {
       // Relink the node to this list
       pFirst->Expunge();
       pFirst->m_pParent = this;
+
+      ASSERT(m_ctNodes == 0);
+      m_ctNodes = 1;
+      IndexAppend(pFirst);
     };
 
     // Unlink a node from its previous neighbor
@@ -53,13 +118,31 @@ class CNode {
     };
 
   public:
-    CNode() : m_pHead(NULL), m_pTail(NULL), m_pParent(NULL), m_pPrev(NULL), m_pNext(NULL)
+    CNode() : m_pHead(NULL), m_pTail(NULL), m_ctNodes(0), m_pIndex(NULL),
+      m_pParent(NULL), m_pPrev(NULL), m_pNext(NULL), m_iIndex(0)
     {
     };
 
-    // Remove this node from any chain upon destruction
+    // Copies are created outside of any chain and without children
+    CNode(const CNode &) : m_pHead(NULL), m_pTail(NULL), m_ctNodes(0), m_pIndex(NULL),
+      m_pParent(NULL), m_pPrev(NULL), m_pNext(NULL), m_iIndex(0)
+    {
+    };
+
+    // Links of this node stay the same
+    CNode &operator=(const CNode &) {
+      return *this;
+    };
+
+    // Remove this node from any chain upon destruction and release its children
     virtual ~CNode() {
       Expunge();
+
+      while (m_pHead != NULL) {
+        m_pHead->Expunge();
+      }
+
+      delete m_pIndex;
     };
 
     // Get the first child node
@@ -81,39 +164,95 @@ class CNode {
     __forceinline bool HasNodes(void) const {
       // Both pointers should either be empty or point to something
       ASSERT((m_pHead == NULL && m_pTail == NULL) || (m_pHead != NULL && m_pTail != NULL));
-      return m_pHead != NULL;
+      ASSERT((m_pHead == NULL) == (m_ctNodes == 0));
+      return m_ctNodes != 0;
     };
 
     // Count all child nodes
-    inline size_t GetNodeCount(void) const {
+    __forceinline size_t GetNodeCount(void) const {
+      return m_ctNodes;
+    };
+
+    // Check if the list of child nodes is intact by going through it (for debugging)
+    // Every child should reference this node as its parent, both of its neighbors should reference it back
+    // and the last child in the chain should be the tail, with the amount of children matching the counter.
+    bool ValidateNodes(void) const {
       size_t ct = 0;
-      CNode *pCheck = m_pHead;
+      const CNode *pPrev = NULL;
 
-      while (pCheck) {
-        pCheck = pCheck->m_pNext;
-        ++ct;
+      for (const CNode *pCheck = m_pHead; pCheck != NULL; pCheck = pCheck->m_pNext) {
+        if (pCheck->m_pParent != this || pCheck->m_pPrev != pPrev) return false;
+
+        // Cyclic chain
+        if (++ct > m_ctNodes) return false;
+
+        pPrev = pCheck;
+      }
+
+      return pPrev == m_pTail && ct == m_ctNodes;
+    };
+
+    // Toggle index of child nodes for fast random access
+    // The index is rebuilt by the next lookup after children have been inserted anywhere but at the end or removed from
+    // anywhere but the end, so list widgets that access nodes in a loop get them in constant time between changes.
+    void SetIndexed(bool bState) {
+      if (bState == IsIndexed()) return;
+
+      if (bState) {
+        m_pIndex = new Index;
+      } else {
+        delete m_pIndex;
+        m_pIndex = NULL;
       }
+    };
 
-      return ct;
+    // Check whether child nodes are indexed
+    __forceinline bool IsIndexed(void) const {
+      return m_pIndex != NULL;
     };
 
     // Get an n-th node from the beginning of child nodes
     inline CNode *GetNode(size_t n) const {
-      for (CNode *pCheck = m_pHead; pCheck != NULL; pCheck = pCheck->m_pNext) {
-        if (n == 0) return pCheck;
-        --n;
+      if (n >= m_ctNodes) return NULL;
+
+      if (m_pIndex != NULL) {
+        IndexUpdate();
+        return m_pIndex->aNodes[n];
       }
 
-      return NULL;
+      // Go from whichever end is closer
+      CNode *pCheck;
+
+      if (n < m_ctNodes / 2) {
+        for (pCheck = m_pHead; n != 0; --n) pCheck = pCheck->m_pNext;
+      } else {
+        for (pCheck = m_pTail, n = m_ctNodes - n - 1; n != 0; --n) pCheck = pCheck->m_pPrev;
+      }
+
+      return pCheck;
     };
 
-    // Check if a certain node exists among the children
-    inline bool IsChild(CNode *pNode) const {
-      for (CNode *pCheck = m_pHead; pCheck != NULL; pCheck = pCheck->m_pNext) {
-        if (pCheck == pNode) return true;
+    // Get position of a child node (returns -1 if it's not a child of this node)
+    inline INDEX IndexOf(const CNode *pNode) const {
+      if (!IsChild(pNode)) return -1;
+
+      if (m_pIndex != NULL) {
+        IndexUpdate();
+        return (INDEX)pNode->m_iIndex;
+      }
+
+      INDEX i = 0;
+
+      for (pNode = pNode->m_pPrev; pNode != NULL; pNode = pNode->m_pPrev) {
+        ++i;
       }
 
-      return false;
+      return i;
+    };
+
+    // Check if a certain node exists among the children
+    __forceinline bool IsChild(const CNode *pNode) const {
+      return pNode != NULL && pNode->m_pParent == this;
     };
 
   public:
@@ -146,9 +285,14 @@ class CNode {
       Expunge();
       m_pParent = pNode->m_pParent;
 
-      // Relink the parent to this new node, if it's at the beginning
-      if (m_pParent != NULL && m_pParent->m_pHead == pNode) {
-        m_pParent->m_pHead = this;
+      if (m_pParent != NULL) {
+        m_pParent->m_ctNodes++;
+        m_pParent->IndexInvalidate();
+
+        // Relink the parent to this new node, if it's at the beginning
+        if (m_pParent->m_pHead == pNode) {
+          m_pParent->m_pHead = this;
+        }
       }
 
       // Remember the node that goes before this one (may be NULL)
@@ -175,9 +319,16 @@ class CNode {
       Expunge();
       m_pParent = pNode->m_pParent;
 
-      // Relink the parent to this new node, if it's at the end
-      if (m_pParent != NULL && m_pParent->m_pTail == pNode) {
-        m_pParent->m_pTail = this;
+      if (m_pParent != NULL) {
+        m_pParent->m_ctNodes++;
+
+        // Relink the parent to this new node, if it's at the end
+        if (m_pParent->m_pTail == pNode) {
+          m_pParent->m_pTail = this;
+          m_pParent->IndexAppend(this);
+        } else {
+          m_pParent->IndexInvalidate();
+        }
       }
 
       // Remember the node that goes after this one (may be NULL)
@@ -203,6 +354,10 @@ class CNode {
 
       // Relink list head and tail
       if (m_pParent != NULL) {
+        ASSERT(m_pParent->m_ctNodes != 0);
+        m_pParent->m_ctNodes--;
+        m_pParent->IndexRemove(this);
+
         if (m_pParent->m_pHead == this) {
           m_pParent->m_pHead = m_pNext;
         }
@@ -216,6 +371,190 @@ class CNode {
       m_pParent = NULL;
       m_pPrev = m_pNext = NULL;
     };
+
+  private:
+    // Move a range of nodes from one chain into another next to some node or at either end of a new parent
+    // Parents of the moved nodes are changed in a single pass and links are only changed at the ends of the range.
+    static void MoveRange(CNode *pFirst, CNode *pLast, CNode *pNewParent, CNode *pPos, bool bAfter) {
+      CNode *pOldParent = pFirst->m_pParent;
+      size_t ct = 0;
+
+      for (CNode *pCheck = pFirst;; pCheck = pCheck->m_pNext) {
+        // The last node should come after the first one in the same chain and the position shouldn't be in the range
+        ASSERT(pCheck != NULL && pCheck != pPos && pCheck != pNewParent && pCheck->m_pParent == pOldParent);
+
+        pCheck->m_pParent = pNewParent;
+        ++ct;
+
+        if (pCheck == pLast) break;
+      }
+
+      // Link neighbors of the range together
+      CNode *pBefore = pFirst->m_pPrev;
+      CNode *pAfter = pLast->m_pNext;
+
+      if (pBefore != NULL) pBefore->m_pNext = pAfter;
+      if (pAfter != NULL) pAfter->m_pPrev = pBefore;
+
+      if (pOldParent != NULL) {
+        if (pOldParent->m_pHead == pFirst) pOldParent->m_pHead = pAfter;
+        if (pOldParent->m_pTail == pLast) pOldParent->m_pTail = pBefore;
+
+        ASSERT(pOldParent->m_ctNodes >= ct);
+        pOldParent->m_ctNodes -= ct;
+        pOldParent->IndexInvalidate();
+      }
+
+      // Insert at either end of the new parent
+      if (pPos == NULL) {
+        ASSERT(pNewParent != NULL);
+        pPos = (bAfter ? pNewParent->m_pTail : pNewParent->m_pHead);
+      }
+
+      // Find new neighbors of the range
+      if (pPos == NULL) {
+        pBefore = pAfter = NULL;
+
+      } else if (bAfter) {
+        pBefore = pPos;
+        pAfter = pPos->m_pNext;
+
+      } else {
+        pBefore = pPos->m_pPrev;
+        pAfter = pPos;
+      }
+
+      // Link the range to them
+      pFirst->m_pPrev = pBefore;
+      pLast->m_pNext = pAfter;
+
+      if (pBefore != NULL) pBefore->m_pNext = pFirst;
+      if (pAfter != NULL) pAfter->m_pPrev = pLast;
+
+      if (pNewParent != NULL) {
+        if (pBefore == NULL) pNewParent->m_pHead = pFirst;
+        if (pAfter == NULL) pNewParent->m_pTail = pLast;
+
+        pNewParent->m_ctNodes += ct;
+        pNewParent->IndexInvalidate();
+      }
+    };
+
+  public:
+    // Move a range of nodes from the first to the last one (inclusive) at the beginning of the list
+    inline void SpliceHead(CNode *pFirst, CNode *pLast) {
+      MoveRange(pFirst, pLast, this, NULL, false);
+    };
+
+    // Move a range of nodes from the first to the last one (inclusive) at the end of the list
+    inline void SpliceTail(CNode *pFirst, CNode *pLast) {
+      MoveRange(pFirst, pLast, this, NULL, true);
+    };
+
+    // Move all child nodes of another node at the end of the list
+    inline void TakeNodes(CNode *pFrom) {
+      if (pFrom == this || pFrom->m_pHead == NULL) return;
+      MoveRange(pFrom->m_pHead, pFrom->m_pTail, this, NULL, true);
+    };
+
+    // Move a range of nodes from the first to the last one (inclusive) in the chain before this node
+    inline void SpliceBefore(CNode *pFirst, CNode *pLast) {
+      MoveRange(pFirst, pLast, m_pParent, this, false);
+    };
+
+    // Move a range of nodes from the first to the last one (inclusive) in the chain after this node
+    inline void SpliceAfter(CNode *pFirst, CNode *pLast) {
+      MoveRange(pFirst, pLast, m_pParent, this, true);
+    };
+
+  private:
+    // Merge two null-terminated chains of sorted nodes, preferring nodes from the left chain when they are equal
+    template<class Comparator> static
+    CNode *MergeSorted(CNode *pLeft, CNode *pRight, Comparator &comp) {
+      CNode *pList = NULL;
+      CNode **ppLink = &pList;
+
+      while (pLeft != NULL && pRight != NULL) {
+        if (comp(pRight, pLeft)) {
+          *ppLink = pRight;
+          ppLink = &pRight->m_pNext;
+          pRight = pRight->m_pNext;
+
+        } else {
+          *ppLink = pLeft;
+          ppLink = &pLeft->m_pNext;
+          pLeft = pLeft->m_pNext;
+        }
+      }
+
+      *ppLink = (pLeft != NULL) ? pLeft : pRight;
+      return pList;
+    };
+
+  public:
+    // Sort child nodes using a comparator that returns true if the first node should go before the second one
+    // Example: node.SortChildren(CompareDepth) with bool CompareDepth(const CNode *pNode1, const CNode *pNode2)
+    // Stable bottom-up merge sort that relinks nodes in place without any memory allocations. Already ordered runs of
+    // nodes are merged through forward links into bins of doubling sizes, so recently merged nodes are merged again
+    // while they're still in cache and lists that barely change between sorts are sorted in very few merges.
+    template<class Comparator>
+    void SortChildren(Comparator comp) {
+      if (m_ctNodes < 2) return;
+
+      // Bin N holds a merged chain of up to 2^N runs
+      CNode *apBins[sizeof(size_t) * 8] = { NULL };
+      size_t ctBins = 0;
+
+      CNode *pNext = m_pHead;
+
+      while (pNext != NULL) {
+        // Cut the next run off
+        CNode *pRun = pNext;
+        CNode *pRunEnd = pRun;
+        pNext = pRun->m_pNext;
+
+        while (pNext != NULL && !comp(pNext, pRunEnd)) {
+          pRunEnd = pNext;
+          pNext = pNext->m_pNext;
+        }
+
+        pRunEnd->m_pNext = NULL;
+
+        // Merge it with full bins, which contain earlier nodes
+        size_t iBin = 0;
+
+        for (; iBin < ctBins && apBins[iBin] != NULL; iBin++) {
+          pRun = MergeSorted(apBins[iBin], pRun, comp);
+          apBins[iBin] = NULL;
+        }
+
+        ASSERT(iBin < sizeof(size_t) * 8);
+        apBins[iBin] = pRun;
+
+        if (iBin == ctBins) ctBins++;
+      }
+
+      // Merge all bins together
+      CNode *pList = NULL;
+
+      for (size_t iBin = 0; iBin < ctBins; iBin++) {
+        if (apBins[iBin] != NULL) {
+          pList = (pList != NULL) ? MergeSorted(apBins[iBin], pList, comp) : apBins[iBin];
+        }
+      }
+
+      // Restore back links
+      CNode *pPrev = NULL;
+
+      for (CNode *pNode = pList; pNode != NULL; pNode = pNode->m_pNext) {
+        pNode->m_pPrev = pPrev;
+        pPrev = pNode;
+      }
+
+      m_pHead = pList;
+      m_pTail = pPrev;
+      IndexInvalidate();
+    };
 };
 
 // Helper class for iteration through node's children
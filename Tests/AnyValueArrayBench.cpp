@@ -0,0 +1,129 @@
+/* Copyright (c) 2026 Dreamy Cecil
+This program is free software; you can redistribute it and/or modify
+it under the terms of version 2 of the GNU General Public License as published by
+the Free Software Foundation
+
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License along
+with this program; if not, write to the Free Software Foundation, Inc.,
+51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA. */
+
+// Bulk conversion benchmark of CAnyValueArray against a list of separate CAnyValue objects
+// g++ -O2 -DNDEBUG -I Tests/Stubs Tests/AnyValueArrayBench.cpp -o AnyValueArrayBench
+
+#include "TestCommon.h"
+
+#include <vector>
+#include "../Objects/AnyValueArray.h"
+
+// Measure average time of converting one value in nanoseconds
+static void MeasureToFloat(const char *strType, CAnyValue::EType eType, size_t ctValues, size_t ctRepeats) {
+  std::vector<CAnyValue> aList;
+  CAnyValueArray aArray;
+
+  for (size_t i = 0; i < ctValues; i++) {
+    CAnyValue val;
+
+    switch (eType) {
+      case CAnyValue::E_VAL_BOOL:  val = CAnyValue((i % 3) != 0); break;
+      case CAnyValue::E_VAL_FLOAT: val = CAnyValue(float(i) * 0.5f); break;
+      default: val = CAnyValue(int(i)); break;
+    }
+
+    aList.push_back(val);
+    aArray.Add(val);
+  }
+
+  std::vector<DOUBLE> aOut(ctValues);
+  double dStart = TestSeconds();
+
+  for (size_t iRepeat = 0; iRepeat < ctRepeats; iRepeat++) {
+    for (size_t i = 0; i < ctValues; i++) aOut[i] = aList[i].ToFloat();
+    _iTestSink += (size_t)aOut[iRepeat % ctValues];
+  }
+
+  const double dList = (TestSeconds() - dStart) * 1e9 / double(ctValues * ctRepeats);
+  dStart = TestSeconds();
+
+  for (size_t iRepeat = 0; iRepeat < ctRepeats; iRepeat++) {
+    aArray.ToFloat(&aOut[0]);
+    _iTestSink += (size_t)aOut[iRepeat % ctValues];
+  }
+
+  const double dArray = (TestSeconds() - dStart) * 1e9 / double(ctValues * ctRepeats);
+
+  printf("%8s %8u %16.2f %16.2f\n", strType, (ULONG)ctValues, dList, dArray);
+};
+
+// Measure average time of converting one placement into a vector and into a matrix in nanoseconds
+static void MeasureSpatial(size_t ctValues, size_t ctRepeats) {
+  std::vector<CAnyValue> aList;
+  CAnyValueArray aArray;
+
+  for (size_t i = 0; i < ctValues; i++) {
+    const FLOAT f = FLOAT(i % 360);
+    CAnyValue val(CPlacement3D(FLOAT3D(f, f * 2.0f, f * 3.0f), ANGLE3D(f, -f, f * 0.5f)));
+
+    aList.push_back(val);
+    aArray.Add(val);
+  }
+
+  std::vector<FLOAT3D> aVectors(ctValues);
+  std::vector<FLOATmatrix3D> aMatrices(ctValues);
+  double adTimes[4];
+
+  double dStart = TestSeconds();
+
+  for (size_t iRepeat = 0; iRepeat < ctRepeats; iRepeat++) {
+    for (size_t i = 0; i < ctValues; i++) aVectors[i] = aList[i].ToVector();
+    _iTestSink += (size_t)aVectors[iRepeat % ctValues](1);
+  }
+
+  adTimes[0] = TestSeconds() - dStart;
+  dStart = TestSeconds();
+
+  for (size_t iRepeat = 0; iRepeat < ctRepeats; iRepeat++) {
+    aArray.ToVector(&aVectors[0]);
+    _iTestSink += (size_t)aVectors[iRepeat % ctValues](1);
+  }
+
+  adTimes[1] = TestSeconds() - dStart;
+  dStart = TestSeconds();
+
+  for (size_t iRepeat = 0; iRepeat < ctRepeats; iRepeat++) {
+    for (size_t i = 0; i < ctValues; i++) aMatrices[i] = aList[i].ToMatrix();
+    _iTestSink += (size_t)aMatrices[iRepeat % ctValues](1, 1);
+  }
+
+  adTimes[2] = TestSeconds() - dStart;
+  dStart = TestSeconds();
+
+  for (size_t iRepeat = 0; iRepeat < ctRepeats; iRepeat++) {
+    aArray.ToMatrix(&aMatrices[0]);
+    _iTestSink += (size_t)aMatrices[iRepeat % ctValues](1, 1);
+  }
+
+  adTimes[3] = TestSeconds() - dStart;
+
+  const double dScale = 1e9 / double(ctValues * ctRepeats);
+  printf("%8s %8u %16.2f %16.2f\n", "vector", (ULONG)ctValues, adTimes[0] * dScale, adTimes[1] * dScale);
+  printf("%8s %8u %16.2f %16.2f\n", "matrix", (ULONG)ctValues, adTimes[2] * dScale, adTimes[3] * dScale);
+};
+
+int main() {
+  printf("%8s %8s %16s %16s\n", "type", "values", "list (ns/value)", "array (ns/value)");
+
+  MeasureToFloat("bool",  CAnyValue::E_VAL_BOOL,  10000, 2000);
+  MeasureToFloat("index", CAnyValue::E_VAL_INDEX, 10000, 2000);
+  MeasureToFloat("float", CAnyValue::E_VAL_FLOAT, 10000, 2000);
+
+  // Placements converted with ToVector() and ToMatrix()
+  MeasureSpatial(10000, 200);
+
+  return 0;
+};
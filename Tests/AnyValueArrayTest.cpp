@@ -0,0 +1,177 @@
+/* Copyright (c) 2026 Dreamy Cecil
+This program is free software; you can redistribute it and/or modify
+it under the terms of version 2 of the GNU General Public License as published by
+the Free Software Foundation
+
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License along
+with this program; if not, write to the Free Software Foundation, Inc.,
+51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA. */
+
+// Checks of CAnyValueArray
+// g++ -O1 -I Tests/Stubs Tests/AnyValueArrayTest.cpp -o AnyValueArrayTest
+
+#include "TestCommon.h"
+
+#include "../Objects/AnyValueArray.h"
+
+static void TestElements(void) {
+  // The array takes the type of the first value
+  CAnyValueArray aVectors;
+  aVectors.Add(FLOAT3D(1, 2, 3));
+  aVectors.Add(FLOAT3D(4, 5, 6));
+
+  TEST_CHECK(aVectors.GetType() == CAnyValue::E_VAL_VECTOR && aVectors.Count() == 2);
+  TEST_CHECK(aVectors.Get(1) == CAnyValue(FLOAT3D(4, 5, 6)));
+
+  aVectors.Set(0, FLOAT3D(7, 8, 9));
+  TEST_CHECK(aVectors.CountColumns() == 3);
+  TEST_CHECK(aVectors.GetColumn(0)[0] == 7 && aVectors.GetColumn(1)[1] == 5 && aVectors.GetColumn(2)[0] == 9);
+
+  // Columns are moved when the array grows
+  for (INDEX i = 0; i < 100; i++) aVectors.Add(FLOAT3D(FLOAT(i), 0, -FLOAT(i)));
+  aVectors.Resize(200);
+
+  TEST_CHECK(aVectors.Get(0) == CAnyValue(FLOAT3D(7, 8, 9)));
+  TEST_CHECK(aVectors.Get(101) == CAnyValue(FLOAT3D(99, 0, -99)));
+  TEST_CHECK(aVectors.Get(199) == CAnyValue(FLOAT3D(0, 0, 0)));
+
+  CAnyValueArray aVectorsCopy;
+  aVectorsCopy = aVectors;
+  TEST_CHECK(aVectorsCopy.Count() == 200 && aVectorsCopy.Get(50) == aVectors.Get(50));
+
+  // Strings are copied and destroyed with the array
+  CAnyValueArray aStrings(CAnyValue::E_VAL_STRING);
+  aStrings.Add("first");
+  aStrings.Resize(3);
+  aStrings.Set(2, "third");
+
+  CAnyValueArray aCopy(aStrings);
+  aStrings.Clear();
+
+  TEST_CHECK(aCopy.Count() == 3);
+  TEST_CHECK(aCopy.GetStrings()[0] == "first" && aCopy.GetStrings()[1] == "" && aCopy.Get(2).ToString() == "third");
+};
+
+static void TestToFloat(void) {
+  CAnyValueArray aBools;
+  aBools.Add(true);
+  aBools.Add(false);
+
+  // Booleans are converted to 0 or 1 like in CAnyValue, even if they are set to something else through a span
+  aBools.GetIndices()[0] = 5;
+
+  DOUBLE ad[2];
+  aBools.ToFloat(ad);
+  TEST_CHECK(ad[0] == 1.0 && ad[1] == 0.0);
+  TEST_CHECK(ad[0] == aBools.Get(0).ToFloat());
+
+  CAnyValueArray aFloats;
+  aFloats.Add(0.5f);
+  aFloats.Add(-2.0f);
+
+  aFloats.ToFloat(ad);
+  TEST_CHECK(ad[0] == 0.5 && ad[1] == -2.0);
+};
+
+// Compare bulk conversions with conversions of separate values
+static void TestSpatial(void) {
+  CAnyValueArray aPlaces, aQuats, aMatrices;
+
+  for (INDEX i = 0; i < 50; i++) {
+    const FLOAT f = FLOAT(i);
+    aPlaces.Add(CPlacement3D(FLOAT3D(f, f * 2, f * 3), ANGLE3D(f, -f, f * 0.5f)));
+
+    FLOATmatrix3D m;
+    MakeRotationMatrix(m, ANGLE3D(f * 7, f * 3, -f));
+    aMatrices.Add(m);
+
+    FLOATquat3D q;
+    q.FromMatrix(m);
+    aQuats.Add(q);
+  }
+
+  FLOAT3D av[50];
+  FLOATmatrix3D am[50];
+
+  aPlaces.ToVector(av);
+  aPlaces.ToMatrix(am);
+
+  for (INDEX i = 0; i < 50; i++) {
+    TEST_CHECK(av[i] == aPlaces.Get(i).ToVector());
+    TEST_CHECK(CAnyValue(am[i]) == CAnyValue(aPlaces.Get(i).ToMatrix()));
+  }
+
+  aMatrices.ToVector(av);
+  aQuats.ToMatrix(am);
+
+  for (INDEX i = 0; i < 50; i++) {
+    TEST_CHECK(av[i] == aMatrices.Get(i).ToVector());
+    TEST_CHECK(CAnyValue(am[i]) == CAnyValue(aQuats.Get(i).ToMatrix()));
+  }
+
+  aMatrices.ToMatrix(am);
+  TEST_CHECK(CAnyValue(am[49]) == aMatrices.Get(49));
+};
+
+static void TestStream(void) {
+  CAnyValueArray aMatrices;
+  aMatrices.Add(FLOATmatrix3D(1.0f));
+  aMatrices.Add(FLOATmatrix3D(2.0f));
+
+  CAnyValueArray aStrings;
+  aStrings.Add("text");
+  aStrings.Add("");
+
+  CTStream strm;
+  strm.strm_pFile = tmpfile();
+  aMatrices.Write_t(strm);
+  aStrings.Write_t(strm);
+
+  strm.SetPos_t(0);
+
+  CAnyValueArray aMatricesRead, aStringsRead;
+  aMatricesRead.Read_t(strm);
+  aStringsRead.Read_t(strm);
+  fclose(strm.strm_pFile);
+
+  TEST_CHECK(aMatricesRead.Count() == 2 && aMatricesRead.Get(1) == aMatrices.Get(1));
+  TEST_CHECK(aStringsRead.Count() == 2 && aStringsRead.Get(0).ToString() == "text");
+
+  // Spatial values are written whole, like CAnyValue writes them, even when there are more than fit into one batch
+  CAnyValueArray aBoxes;
+
+  for (INDEX i = 0; i < 300; i++) {
+    aBoxes.Add(FLOATaabbox3D(FLOAT3D(0, FLOAT(i), 0), FLOAT3D(FLOAT(i), 1, 2)));
+  }
+
+  strm.strm_pFile = tmpfile();
+  aBoxes.Write_t(strm);
+
+  // Type, amount of values as a two-byte integer and values
+  FLOATaabbox3D box;
+  strm.SetPos_t(3 + 123 * sizeof(FLOATaabbox3D));
+  strm.Read_t(&box, sizeof(box));
+  TEST_CHECK(CAnyValue(box) == aBoxes.Get(123));
+
+  CAnyValueArray aBoxesRead;
+  strm.SetPos_t(0);
+  aBoxesRead.Read_t(strm);
+  fclose(strm.strm_pFile);
+
+  TEST_CHECK(aBoxesRead.Count() == 300 && aBoxesRead.Get(299) == aBoxes.Get(299) && aBoxesRead.Get(0) == aBoxes.Get(0));
+};
+
+int main() {
+  TestElements();
+  TestToFloat();
+  TestSpatial();
+  TestStream();
+
+  return TestResult("AnyValueArrayTest");
+};
@@ -0,0 +1,355 @@
+/* Copyright (c) 2026 Dreamy Cecil
+This program is free software; you can redistribute it and/or modify
+it under the terms of version 2 of the GNU General Public License as published by
+the Free Software Foundation
+
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License along
+with this program; if not, write to the Free Software Foundation, Inc.,
+51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA. */
+
+// Converter benchmark of CAnyValue against the virtual holders that it used to have
+// g++ -O2 -DNDEBUG -I Tests/Stubs Tests/AnyValueBench.cpp -o AnyValueBench
+// Add -DANYVALUE_HOLDER_POOLS to measure values with pooled holders
+
+// Global allocations are counted by replacing them with malloc, which GCC mistakes for a mismatch
+#if defined(__GNUC__) && !defined(__clang__) && __GNUC__ >= 11
+  #pragma GCC diagnostic ignored "-Wmismatched-new-delete"
+#endif
+
+#include "TestCommon.h"
+
+#include <new>
+#include <vector>
+#include "../Objects/AnyValue.h"
+
+// Amount of global allocations
+static size_t _ctAllocations = 0;
+
+#if __cplusplus >= 201103L || defined(_MSC_VER)
+  #define BENCH_THROW_BAD_ALLOC
+#else
+  #define BENCH_THROW_BAD_ALLOC throw(std::bad_alloc)
+#endif
+
+void *operator new(size_t ct) BENCH_THROW_BAD_ALLOC {
+  _ctAllocations++;
+
+  void *p = malloc(ct != 0 ? ct : 1);
+  if (p == NULL) throw std::bad_alloc();
+  return p;
+};
+
+void operator delete(void *p) throw() {
+  free(p);
+};
+
+// Previous implementation of CAnyValue that kept every value on the heap and got its type through a virtual call
+// Only has the types that are needed for the benchmark
+class CVirtualValue {
+  public:
+    typedef CAnyValue::EType EType;
+
+    struct Placeholder {
+      virtual ~Placeholder() {};
+      virtual EType GetType() const = 0;
+      virtual Placeholder *Clone() const = 0;
+    };
+
+    template<class Type, EType eType>
+    struct Holder : public Placeholder {
+      Type _value;
+
+      Holder(const Type &valSet) : _value(valSet) {};
+      virtual EType GetType() const { return eType; };
+      virtual Placeholder *Clone() const { return new Holder(_value); };
+    };
+
+    typedef Holder<INDEX,  CAnyValue::E_VAL_BOOL>   Bool_t;
+    typedef Holder<INDEX,  CAnyValue::E_VAL_INDEX>  Int_t;
+    typedef Holder<FLOAT,  CAnyValue::E_VAL_FLOAT>  Float_t;
+    typedef Holder<DOUBLE, CAnyValue::E_VAL_DOUBLE> Double_t;
+    typedef Holder<FLOAT3D, CAnyValue::E_VAL_VECTOR> Vector_t;
+    typedef Holder<CPlacement3D, CAnyValue::E_VAL_PLACE> Place_t;
+    typedef Holder<FLOATmatrix3D, CAnyValue::E_VAL_MATRIX> Matrix_t;
+
+  private:
+    Placeholder *_content;
+
+  public:
+    CVirtualValue() : _content(NULL) {};
+    CVirtualValue(bool   bSet) : _content(new Bool_t  (bSet)) {};
+    CVirtualValue(int    iSet) : _content(new Int_t   (iSet)) {};
+    CVirtualValue(float  fSet) : _content(new Float_t (fSet)) {};
+    CVirtualValue(double fSet) : _content(new Double_t(fSet)) {};
+    CVirtualValue(const FLOAT3D &vSet) : _content(new Vector_t(vSet)) {};
+    CVirtualValue(const CPlacement3D &plSet) : _content(new Place_t(plSet)) {};
+    CVirtualValue(const FLOATmatrix3D &mSet) : _content(new Matrix_t(mSet)) {};
+    CVirtualValue(const CVirtualValue &other) : _content(other._content != NULL ? other._content->Clone() : NULL) {};
+
+    ~CVirtualValue() {
+      delete _content;
+    };
+
+    CVirtualValue &operator=(const CVirtualValue &other) {
+      Placeholder *pNew = (other._content != NULL) ? other._content->Clone() : NULL;
+      delete _content;
+      _content = pNew;
+      return *this;
+    };
+
+    inline EType GetType() const {
+      return (_content != NULL) ? _content->GetType() : CAnyValue::E_VAL_NULL;
+    };
+
+    inline bool IsTrue(void) const {
+      switch (GetType()) {
+        case CAnyValue::E_VAL_BOOL:   return ((Bool_t   *)_content)->_value != 0;
+        case CAnyValue::E_VAL_INDEX:  return ((Int_t    *)_content)->_value != 0;
+        case CAnyValue::E_VAL_FLOAT:  return ((Float_t  *)_content)->_value != 0.0f;
+        case CAnyValue::E_VAL_DOUBLE: return ((Double_t *)_content)->_value != 0.0;
+      }
+      return false;
+    };
+
+    inline INDEX ToIndex(void) const {
+      switch (GetType()) {
+        case CAnyValue::E_VAL_BOOL:   return ((Bool_t   *)_content)->_value;
+        case CAnyValue::E_VAL_INDEX:  return ((Int_t    *)_content)->_value;
+        case CAnyValue::E_VAL_FLOAT:  return (INDEX)((Float_t  *)_content)->_value;
+        case CAnyValue::E_VAL_DOUBLE: return (INDEX)((Double_t *)_content)->_value;
+      }
+      return 0;
+    };
+
+    inline DOUBLE ToFloat(void) const {
+      switch (GetType()) {
+        case CAnyValue::E_VAL_BOOL:   return ((Bool_t   *)_content)->_value;
+        case CAnyValue::E_VAL_INDEX:  return ((Int_t    *)_content)->_value;
+        case CAnyValue::E_VAL_FLOAT:  return ((Float_t  *)_content)->_value;
+        case CAnyValue::E_VAL_DOUBLE: return ((Double_t *)_content)->_value;
+      }
+      return 0.0;
+    };
+
+    inline CTString ToString(void) const {
+      switch (GetType()) {
+        case CAnyValue::E_VAL_BOOL:   return ((Bool_t *)_content)->_value ? "1" : "0";
+        case CAnyValue::E_VAL_INDEX:  return CTString(0, "%d", ((Int_t    *)_content)->_value);
+        case CAnyValue::E_VAL_FLOAT:  return CTString(0, "%g", ((Float_t  *)_content)->_value);
+        case CAnyValue::E_VAL_DOUBLE: return CTString(0, "%g", ((Double_t *)_content)->_value);
+      }
+      return "";
+    };
+};
+
+// Average times of different operations in nanoseconds
+struct ValueTimes {
+  double dCopy, dType, dTruth, dIndex, dFloat, dString;
+};
+
+// Time that has passed since some moment divided by amount of operations in nanoseconds
+static double NanosecondsSince(double &dStart, size_t ctOperations) {
+  const double dNow = TestSeconds();
+  const double dResult = (dNow - dStart) * 1e9 / (double)ctOperations;
+  dStart = dNow;
+  return dResult;
+};
+
+// Measure operations on a list of integers, floats, doubles and booleans
+template<class Value>
+ValueTimes MeasureValues(size_t ctValues, size_t ctRepeats) {
+  std::vector<Value> aValues;
+  aValues.reserve(ctValues);
+
+  for (size_t i = 0; i < ctValues; i++) {
+    switch (i % 4) {
+      case 0: aValues.push_back(Value(int(i))); break;
+      case 1: aValues.push_back(Value(float(i) * 0.5f)); break;
+      case 2: aValues.push_back(Value(double(i) * 0.25)); break;
+      default: aValues.push_back(Value((i & 4) != 0)); break;
+    }
+  }
+
+  const size_t ctOperations = ctValues * ctRepeats;
+  ValueTimes times;
+  double dStart = TestSeconds();
+
+  for (size_t iRepeat = 0; iRepeat < ctRepeats / 10; iRepeat++) {
+    std::vector<Value> aCopies(aValues);
+    _iTestSink += aCopies.size();
+  }
+  times.dCopy = NanosecondsSince(dStart, ctOperations / 10);
+
+  for (size_t iRepeat = 0; iRepeat < ctRepeats; iRepeat++) {
+    for (size_t i = 0; i < ctValues; i++) _iTestSink += aValues[i].GetType();
+  }
+  times.dType = NanosecondsSince(dStart, ctOperations);
+
+  for (size_t iRepeat = 0; iRepeat < ctRepeats; iRepeat++) {
+    for (size_t i = 0; i < ctValues; i++) _iTestSink += aValues[i].IsTrue();
+  }
+  times.dTruth = NanosecondsSince(dStart, ctOperations);
+
+  for (size_t iRepeat = 0; iRepeat < ctRepeats; iRepeat++) {
+    for (size_t i = 0; i < ctValues; i++) _iTestSink += aValues[i].ToIndex();
+  }
+  times.dIndex = NanosecondsSince(dStart, ctOperations);
+
+  for (size_t iRepeat = 0; iRepeat < ctRepeats; iRepeat++) {
+    for (size_t i = 0; i < ctValues; i++) _iTestSink += (size_t)aValues[i].ToFloat();
+  }
+  times.dFloat = NanosecondsSince(dStart, ctOperations);
+
+  for (size_t iRepeat = 0; iRepeat < ctRepeats / 100; iRepeat++) {
+    for (size_t i = 0; i < ctValues; i++) _iTestSink += aValues[i].ToString().Length();
+  }
+  times.dString = NanosecondsSince(dStart, ctOperations / 100);
+
+  return times;
+};
+
+// Count allocations of copying a list of vectors and then assigning them to each other one by one
+template<class Value>
+size_t CountVectorCopies(size_t ctValues) {
+  std::vector<Value> aValues;
+
+  for (size_t i = 0; i < ctValues; i++) {
+    aValues.push_back(Value(FLOAT3D(FLOAT(i), 1.0f, 2.0f)));
+  }
+
+  const size_t ctStart = _ctAllocations;
+  std::vector<Value> aCopies(aValues);
+
+  for (size_t i = 0; i < ctValues; i++) {
+    aCopies[i] = aValues[ctValues - 1 - i];
+  }
+
+  return _ctAllocations - ctStart;
+};
+
+// Measure average time of one round of assigning big values to a list and then clearing half of them in microseconds
+template<class Value>
+double MeasureBigValues(size_t ctValues, size_t ctRounds, size_t &ctAllocations) {
+  std::vector<Value> aValues(ctValues);
+  const FLOATmatrix3D m(1.0f);
+  const CPlacement3D pl(FLOAT3D(1, 2, 3), ANGLE3D(4, 5, 6));
+
+  const size_t ctStart = _ctAllocations;
+  const double dStart = TestSeconds();
+
+  for (size_t iRound = 0; iRound < ctRounds; iRound++) {
+    for (size_t i = 0; i < ctValues; i++) {
+      if (i & 1) {
+        aValues[i] = Value(m);
+      } else {
+        aValues[i] = Value(pl);
+      }
+    }
+
+    for (size_t i = iRound & 1; i < ctValues; i += 2) {
+      aValues[i] = Value();
+    }
+  }
+
+  ctAllocations = _ctAllocations - ctStart;
+  return (TestSeconds() - dStart) * 1e6 / (double)ctRounds;
+};
+
+// Measure average time of copying one big value in nanoseconds, either by making own copies or by sharing them
+static double MeasureBigCopies(bool bShared, size_t ctValues, size_t ctRepeats) {
+  std::vector<CAnyValue> aValues;
+
+  for (size_t i = 0; i < ctValues; i++) {
+    if (i & 1) {
+      aValues.push_back(CAnyValue(FLOATmatrix3D(FLOAT(i))));
+    } else {
+      aValues.push_back(CAnyValue("A string that is long enough to not fit into any small string buffer"));
+    }
+
+    if (bShared) aValues.back().MakeShared();
+  }
+
+  const double dStart = TestSeconds();
+
+  for (size_t iRepeat = 0; iRepeat < ctRepeats; iRepeat++) {
+    std::vector<CAnyValue> aCopies(aValues);
+    _iTestSink += aCopies.size();
+  }
+
+  return (TestSeconds() - dStart) * 1e9 / double(ctValues * ctRepeats);
+};
+
+// Measure average time of summing one value of a float column in nanoseconds, either by its type or by converting it
+static double MeasureFloatColumn(bool bTyped, size_t ctValues, size_t ctRepeats) {
+  std::vector<CAnyValue> aValues;
+
+  for (size_t i = 0; i < ctValues; i++) {
+    aValues.push_back(CAnyValue(float(i) * 0.5f));
+  }
+
+  DOUBLE dSum = 0.0;
+  const double dStart = TestSeconds();
+
+  for (size_t iRepeat = 0; iRepeat < ctRepeats; iRepeat++) {
+    if (bTyped) {
+      for (size_t i = 0; i < ctValues; i++) dSum += aValues[i].Get<CAnyValue::Float_t>();
+    } else {
+      for (size_t i = 0; i < ctValues; i++) dSum += aValues[i].ToFloat();
+    }
+  }
+
+  const double dResult = (TestSeconds() - dStart) * 1e9 / double(ctValues * ctRepeats);
+  _iTestSink += (size_t)dSum;
+
+  return dResult;
+};
+
+int main() {
+  printf("sizeof: virtual %u, current %u\n", (ULONG)sizeof(CVirtualValue), (ULONG)sizeof(CAnyValue));
+  printf("%8s %10s %10s %10s %10s %10s %10s\n", "(ns)", "copy", "GetType", "IsTrue", "ToIndex", "ToFloat", "ToString");
+
+  const ValueTimes timesVirtual = MeasureValues<CVirtualValue>(4096, 2000);
+  const ValueTimes timesCurrent = MeasureValues<CAnyValue>(4096, 2000);
+
+  printf("%8s %10.2f %10.2f %10.2f %10.2f %10.2f %10.1f\n", "virtual", timesVirtual.dCopy, timesVirtual.dType,
+    timesVirtual.dTruth, timesVirtual.dIndex, timesVirtual.dFloat, timesVirtual.dString);
+
+  printf("%8s %10.2f %10.2f %10.2f %10.2f %10.2f %10.1f\n", "current", timesCurrent.dCopy, timesCurrent.dType,
+    timesCurrent.dTruth, timesCurrent.dIndex, timesCurrent.dFloat, timesCurrent.dString);
+
+  printf("\nallocations of copying and assigning 1000 vectors: virtual %u, current %u\n",
+    (ULONG)CountVectorCopies<CVirtualValue>(1000), (ULONG)CountVectorCopies<CAnyValue>(1000));
+
+  size_t ctVirtualAllocations, ctCurrentAllocations;
+  const double dVirtual = MeasureBigValues<CVirtualValue>(256, 400, ctVirtualAllocations);
+  const double dCurrent = MeasureBigValues<CAnyValue>(256, 400, ctCurrentAllocations);
+
+  printf("\n400 rounds of assigning 256 matrices and placements and clearing half of them:\n");
+  printf("virtual: %.2f us per round, %u allocations\n", dVirtual, (ULONG)ctVirtualAllocations);
+  printf("current: %.2f us per round, %u allocations", dCurrent, (ULONG)ctCurrentAllocations);
+
+  if (CAnyValue::GetPool(CAnyValue::E_VAL_MATRIX) != NULL) {
+    printf(" (pools: %u + %u slabs)", (ULONG)CAnyValue::GetPool(CAnyValue::E_VAL_MATRIX)->slabs(),
+      (ULONG)CAnyValue::GetPool(CAnyValue::E_VAL_PLACE)->slabs());
+  }
+
+  printf("\n");
+
+  const double dDeep = MeasureBigCopies(false, 4096, 200);
+  const double dShared = MeasureBigCopies(true, 4096, 200);
+
+  printf("\ncopying matrices and strings: deep %.2f ns, shared %.2f ns\n", dDeep, dShared);
+
+  const double dConverted = MeasureFloatColumn(false, 4096, 2000);
+  const double dTyped = MeasureFloatColumn(true, 4096, 2000);
+
+  printf("\nsumming a float column: ToFloat %.2f ns, Get<Float_t> %.2f ns\n", dConverted, dTyped);
+
+  return 0;
+};
@@ -0,0 +1,236 @@
+/* Copyright (c) 2026 Dreamy Cecil
+This program is free software; you can redistribute it and/or modify
+it under the terms of version 2 of the GNU General Public License as published by
+the Free Software Foundation
+
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License along
+with this program; if not, write to the Free Software Foundation, Inc.,
+51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA. */
+
+// Checks of binary serialization of CAnyValue
+// g++ -O1 -I Tests/Stubs Tests/AnyValueStreamTest.cpp -o AnyValueStreamTest
+
+#include "TestCommon.h"
+
+#include "../Objects/AnyValue.h"
+
+// Random 32 bits
+static ULONG RandomBits(ULONG &ulSeed) {
+  ulSeed = ulSeed * 1664525UL + 1013904223UL;
+  const ULONG ulHigh = ulSeed >> 16;
+
+  ulSeed = ulSeed * 1664525UL + 1013904223UL;
+  return (ulHigh << 16) | (ulSeed >> 16);
+};
+
+// Float out of random bits, including infinities and NaNs
+static FLOAT RandomFloat(ULONG &ulSeed) {
+  const ULONG ulBits = RandomBits(ulSeed);
+
+  FLOAT f;
+  memcpy(&f, &ulBits, sizeof(f));
+  return f;
+};
+
+static FLOAT3D RandomVector(ULONG &ulSeed) {
+  const FLOAT fX = RandomFloat(ulSeed);
+  const FLOAT fY = RandomFloat(ulSeed);
+  return FLOAT3D(fX, fY, RandomFloat(ulSeed));
+};
+
+// Generate value of any type that can be serialized
+static CAnyValue RandomValue(ULONG &ulSeed) {
+  switch (RandomBits(ulSeed) % 12) {
+    case 0: return CAnyValue();
+    case 1: return CAnyValue((RandomBits(ulSeed) & 1) != 0);
+    case 2: return CAnyValue((int)RandomBits(ulSeed) >> (RandomBits(ulSeed) % 32));
+    case 3: return CAnyValue(RandomFloat(ulSeed));
+
+    case 4: {
+      const UQUAD uqBits = (UQUAD(RandomBits(ulSeed)) << 32) | RandomBits(ulSeed);
+      DOUBLE d;
+      memcpy(&d, &uqBits, sizeof(d));
+      return CAnyValue(d);
+    }
+
+    case 5: {
+      CTString str;
+      const ULONG ctChars = RandomBits(ulSeed) % 40;
+
+      for (ULONG i = 0; i < ctChars; i++) {
+        const char strChar[2] = { char(1 + RandomBits(ulSeed) % 255), '\0' };
+        str += strChar;
+      }
+
+      return CAnyValue(str);
+    }
+
+    case 6: return CAnyValue(RandomVector(ulSeed));
+    case 7: return CAnyValue(FLOATplane3D(RandomVector(ulSeed), RandomFloat(ulSeed)));
+    case 8: return CAnyValue(CPlacement3D(RandomVector(ulSeed), RandomVector(ulSeed)));
+
+    case 9: {
+      FLOATaabbox3D box;
+      box.minvect = RandomVector(ulSeed);
+      box.maxvect = RandomVector(ulSeed);
+      return CAnyValue(box);
+    }
+
+    case 10: {
+      const FLOAT3D v = RandomVector(ulSeed);
+      return CAnyValue(FLOATquat3D(v(1), v(2), v(3), RandomFloat(ulSeed)));
+    }
+
+    default: {
+      FLOATmatrix3D m;
+      for (int i = 0; i < 9; i++) m.matrix[i / 3][i % 3] = RandomFloat(ulSeed);
+      return CAnyValue(m);
+    }
+  }
+};
+
+// Read everything from a stream and check if it throws an error
+static bool ReadThrows(CTStream &strm, bool bMap) {
+  strm.SetPos_t(0);
+
+  try {
+    if (bMap) {
+      se1::map<CTString, CAnyValue> mapValues;
+      CAnyValue::ReadMap_t(strm, mapValues);
+    } else {
+      std::vector<CAnyValue> aValues;
+      CAnyValue::ReadList_t(strm, aValues);
+    }
+
+  } catch (char *strError) {
+    free(strError);
+    return true;
+  }
+
+  return false;
+};
+
+static void TestRoundTrip(void) {
+  ULONG ulSeed = 1;
+  std::vector<CAnyValue> aValues;
+
+  for (int i = 0; i < 5000; i++) {
+    aValues.push_back(RandomValue(ulSeed));
+  }
+
+  se1::map<CTString, CAnyValue> mapValues;
+  mapValues["Speed"] = CAnyValue(12);
+  mapValues["Name"] = CAnyValue("Player");
+  mapValues["Axes"] = CAnyValue(FLOATmatrix3D(1.0f));
+
+  CTStream strm;
+  strm.strm_pFile = tmpfile();
+  CAnyValue::WriteList_t(strm, aValues);
+  CAnyValue::WriteMap_t(strm, mapValues);
+
+  strm.SetPos_t(0);
+
+  std::vector<CAnyValue> aRead;
+  se1::map<CTString, CAnyValue> mapRead;
+  CAnyValue::ReadList_t(strm, aRead);
+  CAnyValue::ReadMap_t(strm, mapRead);
+
+  TEST_CHECK(strm.GetPos_t() == strm.GetStreamSize());
+  fclose(strm.strm_pFile);
+
+  // Values are compared by their bits, so floats must be exact
+  TEST_CHECK(aRead.size() == aValues.size());
+  int ctDifferent = 0;
+
+  for (size_t i = 0; i < aRead.size() && i < aValues.size(); i++) {
+    if (aRead[i] != aValues[i]) ctDifferent++;
+  }
+
+  TEST_CHECK(ctDifferent == 0);
+  TEST_CHECK(mapRead.size() == 3 && mapRead["Speed"] == CAnyValue(12) && mapRead["Name"] == CAnyValue("Player"));
+  TEST_CHECK(mapRead["Axes"] == CAnyValue(FLOATmatrix3D(1.0f)));
+};
+
+static void TestErrors(void) {
+  // Pointers cannot be serialized
+  CTStream strm;
+  strm.strm_pFile = tmpfile();
+
+  bool bThrown = false;
+
+  try {
+    CAnyValue((void *)&strm).Write_t(strm);
+  } catch (char *strError) {
+    free(strError);
+    bThrown = true;
+  }
+
+  TEST_CHECK(bThrown);
+  fclose(strm.strm_pFile);
+
+  // Every truncated list and map throws an error
+  ULONG ulSeed = 2;
+  int ctNotThrown = 0;
+
+  for (int iInput = 0; iInput < 300; iInput++) {
+    std::vector<CAnyValue> aValues;
+    for (int i = 0; i < 5; i++) aValues.push_back(RandomValue(ulSeed));
+
+    se1::map<CTString, CAnyValue> mapValues;
+    mapValues["Key"] = RandomValue(ulSeed);
+
+    const bool bMap = (iInput & 1) != 0;
+
+    strm.strm_pFile = tmpfile();
+
+    if (bMap) {
+      CAnyValue::WriteMap_t(strm, mapValues);
+    } else {
+      CAnyValue::WriteList_t(strm, aValues);
+    }
+
+    const SLONG slSize = strm.GetStreamSize();
+    std::vector<UBYTE> aData(slSize);
+    strm.SetPos_t(0);
+    strm.Read_t(&aData[0], slSize);
+    fclose(strm.strm_pFile);
+
+    const SLONG slCut = RandomBits(ulSeed) % slSize;
+    strm.strm_pFile = tmpfile();
+    strm.Write_t(&aData[0], slCut);
+
+    if (!ReadThrows(strm, bMap)) ctNotThrown++;
+    fclose(strm.strm_pFile);
+
+    // Corrupted bytes may still make up valid values but reading them must not crash
+    aData[RandomBits(ulSeed) % slSize] = UBYTE(RandomBits(ulSeed));
+    strm.strm_pFile = tmpfile();
+    strm.Write_t(&aData[0], slSize);
+
+    ReadThrows(strm, bMap);
+    fclose(strm.strm_pFile);
+  }
+
+  TEST_CHECK(ctNotThrown == 0);
+
+  // Counts that exceed the stream throw an error instead of allocating
+  static const UBYTE aubHuge[5] = { 0xFF, 0xFF, 0xFF, 0xFF, 0x0F };
+  strm.strm_pFile = tmpfile();
+  strm.Write_t(aubHuge, sizeof(aubHuge));
+
+  TEST_CHECK(ReadThrows(strm, false));
+  fclose(strm.strm_pFile);
+};
+
+int main() {
+  TestRoundTrip();
+  TestErrors();
+
+  return TestResult("AnyValueStreamTest");
+};
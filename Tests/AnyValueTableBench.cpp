@@ -0,0 +1,88 @@
+/* Copyright (c) 2026 Dreamy Cecil
+This program is free software; you can redistribute it and/or modify
+it under the terms of version 2 of the GNU General Public License as published by
+the Free Software Foundation
+
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License along
+with this program; if not, write to the Free Software Foundation, Inc.,
+51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA. */
+
+// Lookup benchmark of maps keyed by values themselves and by their string representations
+// g++ -O2 -DNDEBUG -I Tests/Stubs Tests/AnyValueTableBench.cpp -o AnyValueTableBench
+
+#include "TestCommon.h"
+
+#include "../Objects/AnyValueTable.h"
+
+// Generate a mix of integers, floats and strings like the ones that come from scripts
+static void MakeValues(std::vector<CAnyValue> &aValues, size_t ct) {
+  char strValue[64];
+
+  for (size_t i = 0; i < ct; i++) {
+    switch (i % 3) {
+      case 0: aValues.push_back(CAnyValue(int(i * 7))); break;
+      case 1: aValues.push_back(CAnyValue(FLOAT(i) * 0.25f)); break;
+
+      default:
+        sprintf(strValue, "Value_%u", (ULONG)i);
+        aValues.push_back(CAnyValue(strValue));
+    }
+  }
+};
+
+// Measure average time of looking up one value by itself in nanoseconds
+static double MeasureValueKeys(const std::vector<CAnyValue> &aValues, size_t ctRepeats) {
+  se1::map<CAnyValue, size_t> map;
+  for (size_t i = 0; i < aValues.size(); i++) map[aValues[i]] = i;
+
+  const double dStart = TestSeconds();
+
+  for (size_t iRepeat = 0; iRepeat < ctRepeats; iRepeat++) {
+    for (size_t i = 0; i < aValues.size(); i++) {
+      _iTestSink += map.find(aValues[i])->second;
+    }
+  }
+
+  return (TestSeconds() - dStart) * 1e9 / double(aValues.size() * ctRepeats);
+};
+
+// Measure average time of looking up one value by its string in nanoseconds
+static double MeasureStringKeys(const std::vector<CAnyValue> &aValues, size_t ctRepeats) {
+  se1::map<CTString, size_t> map;
+  for (size_t i = 0; i < aValues.size(); i++) map[aValues[i].ToString()] = i;
+
+  const double dStart = TestSeconds();
+
+  for (size_t iRepeat = 0; iRepeat < ctRepeats; iRepeat++) {
+    for (size_t i = 0; i < aValues.size(); i++) {
+      _iTestSink += map.find(aValues[i].ToString())->second;
+    }
+  }
+
+  return (TestSeconds() - dStart) * 1e9 / double(aValues.size() * ctRepeats);
+};
+
+int main() {
+  static const size_t aCounts[3] = { 100, 1000, 10000 };
+
+  printf("%8s %18s %18s %8s\n", "values", "string (ns/find)", "value (ns/find)", "speedup");
+
+  for (int iSize = 0; iSize < 3; iSize++) {
+    std::vector<CAnyValue> aValues;
+    MakeValues(aValues, aCounts[iSize]);
+
+    const size_t ctRepeats = 1000000 / aCounts[iSize];
+    const double dString = MeasureStringKeys(aValues, ctRepeats);
+    const double dValue = MeasureValueKeys(aValues, ctRepeats);
+
+    printf("%8u %18.2f %18.2f %7.2fx\n", (ULONG)aCounts[iSize], dString, dValue, dString / dValue);
+  }
+
+  return 0;
+};
@@ -0,0 +1,71 @@
+/* Copyright (c) 2026 Dreamy Cecil
+This program is free software; you can redistribute it and/or modify
+it under the terms of version 2 of the GNU General Public License as published by
+the Free Software Foundation
+
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License along
+with this program; if not, write to the Free Software Foundation, Inc.,
+51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA. */
+
+// Checks of CAnyValue comparisons and CAnyValueTable
+// g++ -O1 -I Tests/Stubs Tests/AnyValueTableTest.cpp -o AnyValueTableTest
+
+#include "TestCommon.h"
+
+#include "../Objects/AnyValueTable.h"
+
+static void TestComparisons(void) {
+  // Values of different types are never equal
+  TEST_CHECK(CAnyValue(1) != CAnyValue(1.0f));
+  TEST_CHECK(CAnyValue(1) == CAnyValue(1) && CAnyValue(1) < CAnyValue(2));
+  TEST_CHECK(CAnyValue(-1.5f) < CAnyValue(0.5f));
+
+  // Strings are compared case-sensitively
+  TEST_CHECK(CAnyValue("abc") == CAnyValue("abc"));
+  TEST_CHECK(CAnyValue("abc") != CAnyValue("ABC"));
+  TEST_CHECK(CAnyValue("abc").Hash() == CAnyValue("abc").Hash());
+
+  TEST_CHECK(CAnyValue(FLOAT3D(1, 2, 3)) == CAnyValue(FLOAT3D(1, 2, 3)));
+  TEST_CHECK(CAnyValue(FLOAT3D(1, 2, 3)).Hash() == CAnyValue(FLOAT3D(1, 2, 3)).Hash());
+};
+
+static void TestInterning(void) {
+  CAnyValueTable table;
+
+  // Equal values share one instance
+  const CAnyValue &val1 = table.Intern(CAnyValue("A string that is long enough to not fit into any buffer"));
+  const CAnyValue &val2 = table.Intern(CAnyValue("A string that is long enough to not fit into any buffer"));
+
+  TEST_CHECK(&val1 == &val2 && table.Count() == 1);
+  TEST_CHECK(table.GetMap().begin()->second == 2);
+
+  table.Intern(CAnyValue(5));
+  TEST_CHECK(table.Contains(CAnyValue(5)) && !table.Contains(CAnyValue(6)));
+  TEST_CHECK(table.Find(CAnyValue(6)) == NULL);
+
+  // Shared values referenced outside the table are kept
+  {
+    CAnyValue valCopy(val1);
+    TEST_CHECK(table.Prune() == 0);
+  }
+
+  // Unreferenced shared values are removed but small values stay
+  TEST_CHECK(table.Prune() == 1 && table.Count() == 1);
+  TEST_CHECK(table.Contains(CAnyValue(5)));
+
+  table.Clear();
+  TEST_CHECK(table.Count() == 0);
+};
+
+int main() {
+  TestComparisons();
+  TestInterning();
+
+  return TestResult("AnyValueTableTest");
+};
@@ -0,0 +1,88 @@
+/* Copyright (c) 2026 Dreamy Cecil
+This program is free software; you can redistribute it and/or modify
+it under the terms of version 2 of the GNU General Public License as published by
+the Free Software Foundation
+
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License along
+with this program; if not, write to the Free Software Foundation, Inc.,
+51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA. */
+
+// Checks of CAnyValue
+// g++ -O1 -I Tests/Stubs Tests/AnyValueTest.cpp -o AnyValueTest
+
+#include "TestCommon.h"
+
+#include "../Objects/AnyValue.h"
+
+static void TestHolders(void) {
+  // Holders can still be used through their placeholder interface
+  CAnyValue::Placeholder *pHolder = new CAnyValue::Matrix_t(FLOATmatrix3D(2.0f));
+  TEST_CHECK(pHolder->GetType() == CAnyValue::E_VAL_MATRIX);
+
+  CAnyValue::Placeholder *pClone = pHolder->Clone();
+  TEST_CHECK(pClone->GetType() == CAnyValue::E_VAL_MATRIX);
+  TEST_CHECK(static_cast<CAnyValue::Matrix_t *>(pClone)->_value(2, 2) == 2.0f);
+
+  delete pHolder;
+  delete pClone;
+};
+
+static void TestConversions(void) {
+  CAnyValue valInt(12);
+  CAnyValue valFloat(0.5f);
+  CAnyValue valDouble(2.25);
+  CAnyValue valBool(true);
+  CAnyValue valString("text");
+
+  TEST_CHECK(valInt.ToIndex() == 12 && valInt.ToFloat() == 12.0);
+  TEST_CHECK(valFloat.ToIndex() == 0 && valFloat.ToFloat() == 0.5);
+  TEST_CHECK(valDouble.ToIndex() == 2 && valDouble.ToFloat() == 2.25);
+  TEST_CHECK(valBool.ToIndex() == 1 && valBool.IsTrue());
+  TEST_CHECK(valString.IsTrue() && !CAnyValue(0).IsTrue());
+
+  TEST_CHECK(valInt.ToString() == "12");
+  TEST_CHECK(valBool.ToString() == "1");
+  TEST_CHECK(valString.ToString() == "text");
+
+  // Spatial conversions
+  CAnyValue valVector(FLOAT3D(1, 2, 3));
+  TEST_CHECK(valVector.ToPlacement().pl_PositionVector == FLOAT3D(1, 2, 3));
+  TEST_CHECK(CAnyValue(valVector.ToMatrix()).ToVector() == FLOAT3D(1, 2, 3));
+};
+
+static void TestCopies(void) {
+  // Big values are in holders and shared ones are referenced by copies
+  CAnyValue valMatrix(FLOATmatrix3D(1.0f));
+  valMatrix.MakeShared();
+
+  CAnyValue valCopy(valMatrix);
+  TEST_CHECK(valCopy.IsShared() && valMatrix.CountRefs() == 2);
+  TEST_CHECK(valCopy == valMatrix);
+
+  // Mutable access makes an own copy
+  valCopy.GetMatrix()(1, 1) = 5.0f;
+  TEST_CHECK(!valCopy.IsShared() && valMatrix.CountRefs() == 1);
+  TEST_CHECK(valMatrix.GetMatrix()(1, 1) == 1.0f && valCopy != valMatrix);
+
+  // Values of any kind can be swapped
+  CAnyValue valString("swapped");
+  valString.Swap(valCopy);
+  TEST_CHECK(valCopy.GetType() == CAnyValue::E_VAL_STRING && valString.GetMatrix()(1, 1) == 5.0f);
+
+  valString = valCopy;
+  TEST_CHECK(valString.GetString() == "swapped");
+};
+
+int main() {
+  TestHolders();
+  TestConversions();
+  TestCopies();
+
+  return TestResult("AnyValueTest");
+};
@@ -0,0 +1,102 @@
+/* Copyright (c) 2026 Dreamy Cecil
+This program is free software; you can redistribute it and/or modify
+it under the terms of version 2 of the GNU General Public License as published by
+the Free Software Foundation
+
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License along
+with this program; if not, write to the Free Software Foundation, Inc.,
+51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA. */
+
+// Checks that separate big values can be used on different threads
+// Build it with a thread sanitizer to check that holders of different values don't share anything:
+// g++ -O1 -fsanitize=thread -I Tests/Stubs Tests/AnyValueThreadTest.cpp -o AnyValueThreadTest -lpthread
+
+#include "TestCommon.h"
+
+#include <vector>
+#include <Engine/Base/Synchronization.h>
+#include "../Objects/AnyValue.h"
+
+#ifdef _WIN32
+  typedef HANDLE TestThread;
+  #define TEST_THREAD_FUNC(_Name) DWORD WINAPI _Name(void *pArg)
+
+  static void StartThread(TestThread &th, LPTHREAD_START_ROUTINE pFunc, void *pArg) {
+    th = CreateThread(NULL, 0, pFunc, pArg, 0, NULL);
+  };
+
+  static void JoinThread(TestThread &th) {
+    WaitForSingleObject(th, INFINITE);
+    CloseHandle(th);
+  };
+
+#else
+  typedef pthread_t TestThread;
+  #define TEST_THREAD_FUNC(_Name) void *_Name(void *pArg)
+
+  static void StartThread(TestThread &th, void *(*pFunc)(void *), void *pArg) {
+    pthread_create(&th, NULL, pFunc, pArg);
+  };
+
+  static void JoinThread(TestThread &th) {
+    pthread_join(th, NULL);
+  };
+#endif
+
+static volatile LONG _ctMismatches = 0;
+
+// Keep creating, copying and destroying big values of each type
+static TEST_THREAD_FUNC(ValueThread) {
+  const FLOAT fThread = FLOAT((size_t)pArg + 1);
+  std::vector<CAnyValue> aValues(64);
+
+  for (int i = 0; i < 20000; i++) {
+    CAnyValue &val = aValues[i % aValues.size()];
+
+    switch (i % 4) {
+      case 0: val = CAnyValue(FLOATmatrix3D(fThread)); break;
+      case 1: val = CAnyValue(CPlacement3D(FLOAT3D(fThread, 0, 0), ANGLE3D(0, 0, 0))); break;
+      case 2: val = CAnyValue(FLOATaabbox3D(FLOAT3D(0, 0, 0), fThread)); break;
+
+      default: {
+        CAnyValue valString("A string that is long enough to not fit into any small string buffer");
+        valString.MakeShared();
+        val = valString;
+      }
+    }
+
+    // Copy the value and make sure it has been kept intact
+    const CAnyValue valCopy(val);
+
+    if (valCopy.GetType() == CAnyValue::E_VAL_MATRIX && valCopy.Get<CAnyValue::Matrix_t>()(1, 1) != fThread) {
+      InterlockedIncrement(&_ctMismatches);
+    }
+  }
+
+  return 0;
+};
+
+int main() {
+  // Pools are shared by all threads, so they must be off
+  TEST_CHECK(CAnyValue::GetPool(CAnyValue::E_VAL_MATRIX) == NULL);
+
+  TestThread athValues[4];
+
+  for (size_t iThread = 0; iThread < 4; iThread++) {
+    StartThread(athValues[iThread], ValueThread, (void *)iThread);
+  }
+
+  for (size_t iThread = 0; iThread < 4; iThread++) {
+    JoinThread(athValues[iThread]);
+  }
+
+  TEST_CHECK(_ctMismatches == 0);
+
+  return TestResult("AnyValueThreadTest");
+};
@@ -0,0 +1,78 @@
+/* Copyright (c) 2026 Dreamy Cecil
+This program is free software; you can redistribute it and/or modify
+it under the terms of version 2 of the GNU General Public License as published by
+the Free Software Foundation
+
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License along
+with this program; if not, write to the Free Software Foundation, Inc.,
+51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA. */
+
+// Loading benchmark of configs with and without an arena
+// g++ -O2 -DNDEBUG -I Tests/Stubs Tests/IniArenaBench.cpp -o IniArenaBench
+
+#include "TestCommon.h"
+
+#include "../Base/IniConfig.h"
+
+// Generate config text with long enough names and values to not fit into string buffers
+static IniStr MakeConfigText(size_t ctSections, size_t ctKeys) {
+  IniStr strText;
+  char strLine[256];
+
+  for (size_t iSection = 0; iSection < ctSections; iSection++) {
+    sprintf(strLine, "[Section_%u]\n", (ULONG)iSection);
+    strText += strLine;
+
+    for (size_t iKey = 0; iKey < ctKeys; iKey++) {
+      sprintf(strLine, "Some_Long_Key_Name_%u = Some value of the key that is long %u\n", (ULONG)iKey, (ULONG)(iKey * 31));
+      strText += strLine;
+    }
+  }
+
+  return strText;
+};
+
+// Measure average time of reading the text into a config and clearing it in milliseconds
+static double MeasureLoads(CIniConfig &ini, const IniStr &strText, int ctRuns) {
+  const double dStart = TestSeconds();
+
+  for (int i = 0; i < ctRuns; i++) {
+    ini.Read(strText);
+    _iTestSink += ini.GetMap().size();
+    ini.Clear();
+  }
+
+  return (TestSeconds() - dStart) * 1e3 / (double)ctRuns;
+};
+
+int main() {
+  static const size_t aKeys[3] = { 10, 100, 1000 };
+
+  printf("%8s %8s %16s %16s %8s\n", "sections", "keys", "heap (ms/load)", "arena (ms/load)", "speedup");
+
+  for (int iSize = 0; iSize < 3; iSize++) {
+    const size_t ctSections = 20;
+    const IniStr strText = MakeConfigText(ctSections, aKeys[iSize]);
+    const int ctRuns = (int)(20000 / aKeys[iSize]);
+
+    CIniConfig iniHeap;
+    CIniConfig iniArena(64 * 1024);
+
+    // Warm up both configs
+    MeasureLoads(iniHeap, strText, 1);
+    MeasureLoads(iniArena, strText, 1);
+
+    const double dHeap = MeasureLoads(iniHeap, strText, ctRuns);
+    const double dArena = MeasureLoads(iniArena, strText, ctRuns);
+
+    printf("%8u %8u %16.3f %16.3f %7.2fx\n", (ULONG)ctSections, (ULONG)aKeys[iSize], dHeap, dArena, dHeap / dArena);
+  }
+
+  return 0;
+};
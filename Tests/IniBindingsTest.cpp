@@ -0,0 +1,76 @@
+/* Copyright (c) 2026 Dreamy Cecil
+This program is free software; you can redistribute it and/or modify
+it under the terms of version 2 of the GNU General Public License as published by
+the Free Software Foundation
+
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License along
+with this program; if not, write to the Free Software Foundation, Inc.,
+51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA. */
+
+// Checks of CIniBindings
+// g++ -O1 -I Tests/Stubs Tests/IniBindingsTest.cpp -o IniBindingsTest
+
+#include "TestCommon.h"
+
+#include "../Base/IniBindings.h"
+
+static void TestApply(void) {
+  SLONG iSpeed = 0;
+  FLOAT fScale = 0.0f;
+  bool bEnabled = false;
+  CTString strName;
+
+  CIniBindings bindings;
+  bindings.BindInt("Game", "Speed", &iSpeed, 1, 0, 10);
+  bindings.BindFloat("Game", "Scale", &fScale, 1.0f);
+  bindings.BindBool("Game", "Enabled", &bEnabled, true);
+  bindings.BindString("Player", "Name", &strName, "Default");
+
+  CIniConfig ini;
+  ini.Read("[Game]\nSpeed = 20\nScale = 0.5\n[Player]\nName = Sam\n");
+
+  TEST_CHECK(bindings.Apply(ini) == 3);
+  TEST_CHECK(iSpeed == 10 && fScale == 0.5f && bEnabled && strName == CTString("Sam"));
+
+  // Conversions are counted in the config and reused by the next reads
+  TEST_CHECK(ini.GetParseStats().ctParses == 2 && ini.GetParseStats().ctHits == 0);
+
+  TEST_CHECK(bindings.Apply(ini) == 3);
+  TEST_CHECK(ini.GetParseStats().ctParses == 2 && ini.GetParseStats().ctHits == 2);
+
+  TEST_CHECK(ini.GetIntValue("Game", "Speed", 0) == 20);
+  TEST_CHECK(ini.GetParseStats().ctParses == 2 && ini.GetParseStats().ctHits == 3);
+
+  // Frozen configs aren't changed
+  CIniConfig iniFrozen;
+  iniFrozen.Read("[Game]\nSpeed = 3\n");
+  iniFrozen.Freeze();
+
+  TEST_CHECK(bindings.Apply(iniFrozen) == 1);
+  TEST_CHECK(iSpeed == 3 && fScale == 1.0f && strName == CTString("Default"));
+  TEST_CHECK(iniFrozen.GetParseStats().ctParses == 0 && iniFrozen.GetParseStats().ctHits == 0);
+};
+
+static void TestApplyText(void) {
+  SLONG iSpeed = 0;
+
+  CIniBindings bindings;
+  bindings.BindInt("Game", "Speed", &iSpeed, 1);
+
+  const char *strText = "[Other]\nSpeed = 5\n[Game]\nSpeed = 7\n";
+  TEST_CHECK(bindings.ApplyText(strText, strText + strlen(strText)) == 1);
+  TEST_CHECK(iSpeed == 7);
+};
+
+int main() {
+  TestApply();
+  TestApplyText();
+
+  return TestResult("IniBindingsTest");
+};
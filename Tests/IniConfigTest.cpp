@@ -0,0 +1,235 @@
+/* Copyright (c) 2026 Dreamy Cecil
+This program is free software; you can redistribute it and/or modify
+it under the terms of version 2 of the GNU General Public License as published by
+the Free Software Foundation
+
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License along
+with this program; if not, write to the Free Software Foundation, Inc.,
+51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA. */
+
+// Checks of CIniConfig
+// g++ -O1 -I Tests/Stubs Tests/IniConfigTest.cpp -o IniConfigTest
+
+#include "TestCommon.h"
+
+#include "../Base/IniConfig.h"
+
+static void TestTypedValues(void) {
+  CIniConfig ini;
+  ini.Read("[Game]\nSpeed = 12\nScale = 1.5\nEnabled = yes\nName = Player\n");
+
+  // The first read of each type converts the text and the next ones take it from the cache
+  TEST_CHECK(ini.GetIntValue("Game", "Speed", 0) == 12);
+  TEST_CHECK(ini.GetIntValue("Game", "Speed", 0) == 12);
+  TEST_CHECK(ini.GetParseStats().ctParses == 1 && ini.GetParseStats().ctHits == 1);
+
+  // Invalid conversions are remembered as well
+  TEST_CHECK(ini.GetIntValue("Game", "Name", -1) == -1);
+  TEST_CHECK(ini.GetIntValue("Game", "Name", -2) == -2);
+  TEST_CHECK(ini.GetParseStats().ctParses == 2 && ini.GetParseStats().ctHits == 2);
+
+  TEST_CHECK(ini.GetDoubleValue("Game", "Scale", 0.0) == 1.5);
+  TEST_CHECK(ini.GetBoolValue("Game", "Enabled", false));
+  TEST_CHECK(ini.GetIntValue("Game", "Missing", 7) == 7);
+
+  // New text resets the cache
+  ini.ResetParseStats();
+  ini.SetValue("Game", "Speed", "20");
+  TEST_CHECK(ini.GetIntValue("Game", "Speed", 0) == 20);
+  TEST_CHECK(ini.GetParseStats().ctParses == 1);
+
+  // Typed values are cached directly
+  ini.ResetParseStats();
+  ini.SetIntValue("Game", "Count", 42);
+  ini.SetBoolValue("Game", "Flag", true);
+  ini.SetDoubleValue("Game", "Exact", 0.1);
+
+  TEST_CHECK(ini.GetIntValue("Game", "Count", 0) == 42);
+  TEST_CHECK(ini.GetBoolValue("Game", "Flag", false));
+  TEST_CHECK(ini.GetDoubleValue("Game", "Exact", 0.0) == 0.1);
+  TEST_CHECK(ini.GetParseStats().ctParses == 0 && ini.GetParseStats().ctHits == 3);
+
+  TEST_CHECK(strcmp(ini.GetValue("Game", "Count"), "42") == 0);
+};
+
+static void TestValueText(void) {
+  CIniValue val("15");
+  IniParseStats stats;
+
+  TEST_CHECK(val.GetInt(0, &stats) == 15);
+  TEST_CHECK(val == "15" && val.length() == 2 && !val.empty());
+
+  // Text can only be changed through assignments that reset the cache
+  val = "abc";
+  TEST_CHECK(val.GetInt(-1, &stats) == -1);
+  TEST_CHECK(val.GetText() == IniStr("abc"));
+  TEST_CHECK(stats.ctParses == 2 && stats.ctHits == 0);
+
+  val = IniStr("0x10");
+  TEST_CHECK(val.GetInt(0, &stats) == 16);
+
+  // Values still convert into STL strings
+  const IniStr strValue = val;
+  TEST_CHECK(strValue == "0x10");
+};
+
+static void TestReadWrite(void) {
+  CIniConfig ini;
+  ini.Read("Global = 1\n[A]\n  Key1 = \" spaced \"\nKey2=2\r\n[B]\nKey = x\n[A]\nKey3 = 3\n");
+
+  TEST_CHECK(ini.GetValue("", "Global") == "1");
+  TEST_CHECK(ini.GetValue("A", "Key1") == " spaced ");
+  TEST_CHECK(ini.GetIntValue("A", "Key3", 0) == 3);
+  TEST_CHECK(ini.GetValue("B", "Key") == "x");
+
+  IniStr strText;
+  ini.Write(strText);
+  TEST_CHECK(strText == "Global = 1\n[A]\nKey1 = \" spaced \"\nKey2 = 2\nKey3 = 3\n[B]\nKey = x\n");
+
+  // Written text is read back the same way
+  CIniConfig iniCopy;
+  iniCopy.Read(strText);
+
+  IniStr strCopy;
+  iniCopy.Write(strCopy);
+  TEST_CHECK(strCopy == strText);
+
+  TEST_CHECK(ini.Delete("A", "Key2") && !ini.KeyExists("A", "Key2"));
+  TEST_CHECK(ini.Delete("B") && !ini.SectionExists("B"));
+};
+
+static void TestArenaText(void) {
+  CIniConfig ini(4096);
+  ini.Read("[Game]\nName = A long enough name to not fit into any string buffer\nSpeed = 5\n");
+
+  // Text of keys and values is in the arena of the config
+  const IniKeys &keys = ini.GetMap().find("Game")->second;
+  TEST_CHECK(keys.begin()->first.IsInArena() && keys.begin()->second.GetText().IsInArena());
+
+  // Keys still convert into STL strings
+  const IniStr strKey = keys.begin()->first;
+  TEST_CHECK(strKey == "Name");
+
+  // Copies of the text keep their own text on the heap
+  CIniText strCopy = keys.begin()->second.GetText();
+  TEST_CHECK(!strCopy.IsInArena() && !strCopy.IsReference());
+
+  // New values stay in the arena
+  ini.SetValue("Game", "Speed", "A replaced value that is long enough to be allocated");
+  TEST_CHECK(ini.FindValue("Game", "Speed")->GetText().IsInArena());
+
+  // Copied config has text in its own arena
+  CIniConfig iniCopy(ini);
+  TEST_CHECK(iniCopy.FindValue("Game", "Name")->GetText().IsInArena());
+  TEST_CHECK(iniCopy.FindValue("Game", "Name") != ini.FindValue("Game", "Name"));
+
+  ini.Clear();
+  TEST_CHECK(strCopy == "A long enough name to not fit into any string buffer");
+  TEST_CHECK(iniCopy.GetValue("Game", "Name") == CTString("A long enough name to not fit into any string buffer"));
+
+  // Configs without an arena keep text on the heap
+  CIniConfig iniHeap;
+  iniHeap.Read("Key = Value\n");
+  TEST_CHECK(!iniHeap.FindValue("", "Key")->GetText().IsInArena());
+  TEST_CHECK(!iniHeap.FindValue("", "Key")->GetText().IsReference());
+};
+
+static void TestKeyHandles(void) {
+  CIniConfig ini;
+  ini.Read("[Game]\nSpeed = 5\n");
+
+  CIniKeyHandle hSpeed(ini, "Game", "Speed");
+  CIniKeyHandle hScale(ini, "Game", "Scale");
+  CIniKeyHandle hNone;
+
+  TEST_CHECK(hSpeed.IsResolved() && hSpeed.Exists() && hSpeed.GetIntValue(0) == 5);
+  TEST_CHECK(!hScale.Exists() && hScale.GetDoubleValue(1.5) == 1.5);
+  TEST_CHECK(!hNone.IsResolved() && !hNone.Exists() && hNone.GetValue("x") == "x");
+
+  // Changed values are read through the same cached value
+  ini.SetValue("Game", "Speed", "7");
+  TEST_CHECK(hSpeed.GetIntValue(0) == 7);
+
+  // Keys that are added later are found again
+  ini.SetValue("Game", "Scale", "2.5");
+  TEST_CHECK(hScale.Exists() && hScale.GetDoubleValue(0.0) == 2.5);
+
+  // Removed keys return defaults
+  ini.Delete("Game", "Speed");
+  TEST_CHECK(!hSpeed.Exists() && hSpeed.GetIntValue(-1) == -1);
+
+  ini.Clear();
+  TEST_CHECK(!hScale.Exists() && hScale.GetValue("none") == "none");
+
+  ini.Read("[Game]\nSpeed = yes\n");
+  TEST_CHECK(hSpeed.GetBoolValue(false));
+};
+
+// Read all bytes of a file
+static IniStr ReadBytes(const char *strFile) {
+  IniStr strBytes;
+  FILE *pFile = fopen(strFile, "rb");
+  if (pFile == NULL) return strBytes;
+
+  int iChar;
+  while ((iChar = fgetc(pFile)) != EOF) strBytes += (char)iChar;
+
+  fclose(pFile);
+  return strBytes;
+};
+
+static void TestSavedFiles(void) {
+  CIniConfig ini;
+  ini.Read("Global = 1\n[Game]\nSpeed = 5\nName = \" spaced \"\n");
+
+  // Files are saved with the same bytes as engine streams write the text
+  IniStr strText;
+  ini.Write(strText);
+
+  CTFileStream strm;
+  strm.Create_t("IniConfigTest_Stream.ini");
+  strm.PutString_t(strText.c_str());
+  strm.Close();
+
+  const IniStr strExpected = ReadBytes("IniConfigTest_Stream.ini");
+  TEST_CHECK(strExpected == "Global = 1\r\n[Game]\r\nSpeed = 5\r\nName = \" spaced \"\r\n");
+
+  ini.Save_t("IniConfigTest_Save.ini");
+  TEST_CHECK(ReadBytes("IniConfigTest_Save.ini") == strExpected);
+
+  TEST_CHECK(ini.SaveChanges_t("IniConfigTest_Changes.ini", false));
+  TEST_CHECK(ReadBytes("IniConfigTest_Changes.ini") == strExpected);
+
+  ini.SetValue("Game", "Speed", "6");
+  TEST_CHECK(ini.SaveChanges_t("IniConfigTest_Changes.ini", true));
+  TEST_CHECK(ReadBytes("IniConfigTest_Changes.ini") == "Global = 1\r\n[Game]\r\nSpeed = 6\r\nName = \" spaced \"\r\n");
+
+  // Saved files are loaded back the same way
+  CIniConfig iniLoaded;
+  iniLoaded.Load_t("IniConfigTest_Save.ini", false);
+
+  IniStr strLoaded;
+  iniLoaded.Write(strLoaded);
+  TEST_CHECK(strLoaded == strText);
+
+  remove("IniConfigTest_Stream.ini");
+  remove("IniConfigTest_Save.ini");
+  remove("IniConfigTest_Changes.ini");
+};
+
+int main() {
+  TestTypedValues();
+  TestValueText();
+  TestReadWrite();
+  TestArenaText();
+  TestKeyHandles();
+  TestSavedFiles();
+
+  return TestResult("IniConfigTest");
+};
@@ -0,0 +1,145 @@
+/* Copyright (c) 2026 Dreamy Cecil
+This program is free software; you can redistribute it and/or modify
+it under the terms of version 2 of the GNU General Public License as published by
+the Free Software Foundation
+
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License along
+with this program; if not, write to the Free Software Foundation, Inc.,
+51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA. */
+
+// Checks of CIniOverlay
+// g++ -O1 -I Tests/Stubs Tests/IniOverlayTest.cpp -o IniOverlayTest
+
+#include "TestCommon.h"
+
+#include "../Base/IniOverlay.h"
+
+static void TestLayers(void) {
+  CIniConfig iniDefaults, iniMod, iniUser;
+  iniDefaults.Read("[Game]\nSpeed = 1\nScale = 2\nName = Default\n");
+  iniMod.Read("[Game]\nSpeed = 10\n[Mod]\nKey = x\n");
+  iniUser.Read("[Game]\nName = Player\n");
+
+  CIniOverlay overlay;
+  overlay.AddLayer(iniDefaults);
+  overlay.AddLayer(iniMod);
+  overlay.AddLayer(iniUser);
+
+  // Keys are taken from the topmost layer that has them
+  TEST_CHECK(overlay.GetIntValue("Game", "Speed", 0) == 10 && overlay.GetLayerOf("Game", "Speed") == 1);
+  TEST_CHECK(overlay.GetIntValue("Game", "Scale", 0) == 2 && overlay.GetLayerOf("Game", "Scale") == 0);
+  TEST_CHECK(overlay.GetValue("Game", "Name") == "Player" && overlay.GetLayerOf("Game", "Name") == 2);
+  TEST_CHECK(overlay.GetValue("Mod", "Key") == "x");
+  TEST_CHECK(!overlay.KeyExists("Game", "Missing") && overlay.GetLayerOf("Game", "Missing") == -1);
+
+  // Changes in layers are picked up by the next lookup
+  iniUser.SetValue("Game", "Speed", "20");
+  TEST_CHECK(overlay.GetIntValue("Game", "Speed", 0) == 20);
+
+  iniUser.Delete("Game", "Speed");
+  TEST_CHECK(overlay.GetIntValue("Game", "Speed", 0) == 10);
+
+  iniDefaults.ResetParseStats();
+  iniMod.Clear();
+  TEST_CHECK(overlay.GetIntValue("Game", "Speed", 0) == 1 && !overlay.KeyExists("Mod", "Key"));
+
+  // Typed values are cached by the layer that provides them
+  overlay.GetIntValue("Game", "Speed", 0);
+  TEST_CHECK(iniDefaults.GetParseStats().ctParses == 1 && iniDefaults.GetParseStats().ctHits == 1);
+};
+
+// Random number in a range
+static ULONG RandomRange(ULONG &ulSeed, ULONG ulRange) {
+  ulSeed = ulSeed * 1664525UL + 1013904223UL;
+  return (ulSeed >> 16) % ulRange;
+};
+
+// Find value of a key by going through each layer from the top
+static const CIniValue *FindInLayers(CIniConfig *aLayers, INDEX ctLayers, const char *strSection, const char *strKey, INDEX &iLayer) {
+  for (iLayer = ctLayers - 1; iLayer >= 0; iLayer--) {
+    const CIniValue *pval = aLayers[iLayer].FindValue(strSection, strKey);
+    if (pval != NULL) return pval;
+  }
+
+  return NULL;
+};
+
+static void TestRandomChanges(void) {
+  static const char *astrSections[] = { "", "A", "B" };
+  static const char *astrKeys[] = { "k0", "k1", "k2", "k3", "k4" };
+
+  ULONG ulSeed = 1;
+  int ctMismatches = 0;
+
+  for (int iRun = 0; iRun < 2000; iRun++) {
+    CIniConfig aLayers[4];
+    const INDEX ctLayers = 1 + RandomRange(ulSeed, 4);
+
+    CIniOverlay overlay;
+    for (INDEX iLayer = 0; iLayer < ctLayers; iLayer++) overlay.AddLayer(aLayers[iLayer]);
+
+    for (int iChange = 0; iChange < 40; iChange++) {
+      CIniConfig &ini = aLayers[RandomRange(ulSeed, ctLayers)];
+      const char *strSection = astrSections[RandomRange(ulSeed, 3)];
+      const char *strKey = astrKeys[RandomRange(ulSeed, 5)];
+      const ULONG ulChange = RandomRange(ulSeed, 20);
+
+      if (ulChange < 12) {
+        char strValue[16];
+        sprintf(strValue, "%u", ulChange);
+        ini.SetValue(strSection, strKey, strValue);
+
+      } else if (ulChange < 16) {
+        ini.Delete(strSection, strKey);
+
+      } else if (ulChange < 18) {
+        ini.Delete(strSection);
+
+      } else if (ulChange < 19) {
+        ini.Clear();
+
+      } else {
+        // Replace the layer with a copy of another one
+        ini.Update(aLayers[RandomRange(ulSeed, ctLayers)]);
+      }
+
+      // Only look up some of the time, so that several changes pile up between refreshes
+      if (RandomRange(ulSeed, 3) != 0) continue;
+
+      for (int iSection = 0; iSection < 3; iSection++) {
+        for (int iKey = 0; iKey < 5; iKey++) {
+          INDEX iExpected, iFound;
+          const CIniValue *pExpected = FindInLayers(aLayers, ctLayers, astrSections[iSection], astrKeys[iKey], iExpected);
+          const CIniValue *pFound = overlay.FindValue(astrSections[iSection], astrKeys[iKey], &iFound);
+
+          if (pFound != pExpected || iFound != iExpected) ctMismatches++;
+        }
+      }
+
+      // The view shouldn't have any keys that don't exist anymore
+      const IniResolvedSections &view = overlay.GetView();
+
+      for (IniResolvedSections::const_iterator it = view.begin(); it != view.end(); it++) {
+        for (IniResolvedKeys::const_iterator itKey = it->second.begin(); itKey != it->second.end(); itKey++) {
+          INDEX iExpected;
+          if (FindInLayers(aLayers, ctLayers, it->first.c_str(), itKey->first.c_str(), iExpected) != itKey->second.pValue) ctMismatches++;
+        }
+      }
+    }
+  }
+
+  TEST_CHECK(ctMismatches == 0);
+};
+
+int main() {
+  TestLayers();
+  TestRandomChanges();
+
+  return TestResult("IniOverlayTest");
+};
@@ -0,0 +1,131 @@
+/* Copyright (c) 2026 Dreamy Cecil
+This program is free software; you can redistribute it and/or modify
+it under the terms of version 2 of the GNU General Public License as published by
+the Free Software Foundation
+
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License along
+with this program; if not, write to the Free Software Foundation, Inc.,
+51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA. */
+
+// Comparison of the in-place config parser with the previous line-by-line parser
+// g++ -O1 -I Tests/Stubs Tests/IniParseTest.cpp -o IniParseTest
+
+#include "TestCommon.h"
+
+#include <sstream>
+#include "../Base/IniConfig.h"
+
+// Previous parser of one config line
+static void ParseLineCopies(CIniConfig &ini, const IniStr &strLine, IniStr &strSection) {
+  #define FIND_SPACES " \t"
+
+  size_t iBeg = strLine.find_first_not_of(FIND_SPACES);
+  if (iBeg == IniStr::npos) return;
+
+  if (strLine[iBeg] == '[') {
+    size_t iEnd = strLine.find_last_not_of(FIND_SPACES);
+
+    if (strLine[iEnd] == ']') {
+      strSection = strLine.substr(iBeg + 1, iEnd - iBeg - 1).c_str();
+      return;
+    }
+  }
+
+  size_t iSeparator = strLine.find('=');
+  if (iSeparator == IniStr::npos) return;
+
+  IniStr strKey = strLine.substr(0, iSeparator);
+  IniStr strVal = strLine.substr(iSeparator + 1);
+
+  {
+    size_t iEnd = strKey.find_last_not_of(FIND_SPACES);
+    strKey = strKey.substr(iBeg, iEnd - iBeg + 1);
+
+    iBeg = strVal.find_first_not_of(FIND_SPACES);
+    iEnd = strVal.find_last_not_of(FIND_SPACES);
+
+    if (iBeg != IniStr::npos && iEnd != IniStr::npos && iBeg != iEnd) {
+      if (strVal[iBeg] == '\"') iBeg++;
+      if (strVal[iEnd] == '\"') iEnd--;
+    }
+
+    if (iBeg == IniStr::npos && iEnd == IniStr::npos) {
+      strVal = "";
+    } else {
+      strVal = strVal.substr(iBeg, iEnd - iBeg + 1);
+    }
+  }
+
+  ini.SetValue(strSection.c_str(), strKey.c_str(), strVal.c_str());
+
+  #undef FIND_SPACES
+};
+
+// Previous parser of the whole config, which replaced carriage returns with line breaks
+static void ReadCopies(CIniConfig &ini, IniStr strText) {
+  size_t iReturn = 0;
+
+  while ((iReturn = strText.find('\r', iReturn)) != IniStr::npos) {
+    strText[iReturn] = '\n';
+  }
+
+  std::istringstream strm(strText);
+  IniStr strLine, strSection;
+
+  while (std::getline(strm, strLine)) {
+    ParseLineCopies(ini, strLine, strSection);
+  }
+};
+
+// Generate random config text out of pieces that matter to the grammar
+static IniStr MakeRandomText(ULONG &ulSeed) {
+  static const char *astrPieces[] = { "[", "]", "=", " ", "\t", "a", "Key", "Value", "\"", "\n", "\r", "\r\n", "[Sec]\n", "[ Sec ]" };
+  static const size_t ctPieces = sizeof(astrPieces) / sizeof(astrPieces[0]);
+
+  IniStr strText;
+  ulSeed = ulSeed * 1664525UL + 1013904223UL;
+  const size_t ct = (ulSeed >> 16) % 60;
+
+  for (size_t i = 0; i < ct; i++) {
+    ulSeed = ulSeed * 1664525UL + 1013904223UL;
+    strText += astrPieces[(ulSeed >> 16) % ctPieces];
+  }
+
+  return strText;
+};
+
+static void TestRandomTexts(void) {
+  ULONG ulSeed = 1;
+  int ctMismatches = 0;
+
+  for (int iText = 0; iText < 50000; iText++) {
+    const IniStr strText = MakeRandomText(ulSeed);
+
+    CIniConfig ini, iniCopies;
+    ini.Read(strText);
+    ReadCopies(iniCopies, strText);
+
+    IniStr strResult, strExpected;
+    ini.Write(strResult);
+    iniCopies.Write(strExpected);
+
+    if (strResult != strExpected) {
+      if (ctMismatches == 0) fprintf(stderr, "Mismatch on: \"%s\"\n", strText.c_str());
+      ctMismatches++;
+    }
+  }
+
+  TEST_CHECK(ctMismatches == 0);
+};
+
+int main() {
+  TestRandomTexts();
+
+  return TestResult("IniParseTest");
+};
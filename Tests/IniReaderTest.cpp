@@ -0,0 +1,203 @@
+/* Copyright (c) 2026 Dreamy Cecil
+This program is free software; you can redistribute it and/or modify
+it under the terms of version 2 of the GNU General Public License as published by
+the Free Software Foundation
+
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License along
+with this program; if not, write to the Free Software Foundation, Inc.,
+51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA. */
+
+// Checks of CIniReader
+// g++ -O1 -I Tests/Stubs Tests/IniReaderTest.cpp -o IniReaderTest
+
+#include "TestCommon.h"
+
+#include "../Base/IniReader.h"
+
+// Handler that writes down all lines it receives
+class CLogHandler : public CIniHandler {
+  public:
+    IniStr m_strLog;
+    int m_ctStopAfter; // Stop reading after this many keys (-1 to read everything)
+
+    CLogHandler() : m_ctStopAfter(-1) {};
+
+    virtual bool OnSection(const IniRange &rSection) {
+      m_strLog += "[" + IniStr(rSection.pchBeg, rSection.pchEnd) + "]\n";
+      return true;
+    };
+
+    virtual bool OnKey(const IniRange &rSection, const IniRange &rKey, const IniRange &rValue) {
+      m_strLog += IniStr(rSection.pchBeg, rSection.pchEnd) + "/" + IniStr(rKey.pchBeg, rKey.pchEnd)
+        + "=" + IniStr(rValue.pchBeg, rValue.pchEnd) + "\n";
+
+      return m_ctStopAfter < 0 || --m_ctStopAfter > 0;
+    };
+
+    virtual void OnEnd(void) {
+      m_strLog += "<end>\n";
+    };
+};
+
+// Generate random config text out of pieces that matter to the grammar
+static IniStr MakeRandomText(ULONG &ulSeed) {
+  static const char *astrPieces[] = { "[", "]", "=", " ", "\t", "a", "Key", "Value", ";", "#", "\"", "\n", "\r", "\r\n", "[Sec]\n" };
+  static const size_t ctPieces = sizeof(astrPieces) / sizeof(astrPieces[0]);
+
+  IniStr strText;
+  ulSeed = ulSeed * 1664525UL + 1013904223UL;
+  const size_t ct = (ulSeed >> 16) % 40;
+
+  for (size_t i = 0; i < ct; i++) {
+    ulSeed = ulSeed * 1664525UL + 1013904223UL;
+    strText += astrPieces[(ulSeed >> 16) % ctPieces];
+  }
+
+  return strText;
+};
+
+// Read text from memory
+static IniStr ReadFromMemory(const IniStr &strText) {
+  CLogHandler handler;
+  CIniReader reader(handler);
+  reader.Parse(strText.c_str(), strText.c_str() + strText.length());
+
+  return handler.m_strLog;
+};
+
+// Read text from a stream in chunks
+static IniStr ReadFromStream(const IniStr &strText, size_t ctChunk) {
+  CTStream strm;
+  strm.strm_pFile = tmpfile();
+  strm.Write_t(strText.c_str(), (SLONG)strText.length());
+  strm.SetPos_t(0);
+
+  CLogHandler handler;
+  CIniReader reader(handler);
+  reader.Parse_t(strm, ctChunk);
+  fclose(strm.strm_pFile);
+
+  return handler.m_strLog;
+};
+
+static void TestLines(void) {
+  const IniStr strLog = ReadFromMemory("Global = 1\n[A]\n; comment\nKey1 = \" spaced \"\r\nKey2=2\n[B]\nKey = x");
+  TEST_CHECK(strLog == "/Global=1\n[A]\nA/Key1= spaced \nA/Key2=2\n[B]\nB/Key=x\n<end>\n");
+
+  // Lines are read the same way from a stream
+  TEST_CHECK(ReadFromStream("Global = 1\n[A]\nKey = 2", 4096) == "/Global=1\n[A]\nA/Key=2\n<end>\n");
+
+  // Lines that don't fit into a chunk are still read whole
+  TEST_CHECK(ReadFromStream("A = 1\nLongKey = Long value\nB = 2\n", 8) == "/A=1\n/LongKey=Long value\n/B=2\n<end>\n");
+};
+
+static void TestRandomChunks(void) {
+  ULONG ulSeed = 1;
+  int ctMismatches = 0;
+
+  for (int iText = 0; iText < 20000; iText++) {
+    const IniStr strText = MakeRandomText(ulSeed);
+    const size_t ctChunk = 1 + iText % 45;
+
+    if (ReadFromStream(strText, ctChunk) != ReadFromMemory(strText)) ctMismatches++;
+  }
+
+  TEST_CHECK(ctMismatches == 0);
+};
+
+// Handler that sets every key in a config
+class CConfigHandler : public CIniHandler {
+  public:
+    CIniConfig m_ini;
+
+    virtual bool OnKey(const IniRange &rSection, const IniRange &rKey, const IniRange &rValue) {
+      m_ini.SetValue(IniStr(rSection.pchBeg, rSection.pchEnd).c_str(), IniStr(rKey.pchBeg, rKey.pchEnd).c_str(),
+        IniStr(rValue.pchBeg, rValue.pchEnd).c_str());
+      return true;
+    };
+};
+
+static void TestLongLines(void) {
+  // Generated config with a line that is many times longer than a chunk
+  IniStr strText = "[Data]\nBefore = 1\nBlob = ";
+  for (int i = 0; i < 20000; i++) strText += char('a' + i % 26);
+  strText += "\nAfter = 2\n";
+
+  CIniConfig ini;
+  ini.Read(strText);
+
+  CTStream strm;
+  strm.strm_pFile = tmpfile();
+  strm.Write_t(strText.c_str(), (SLONG)strText.length());
+  strm.SetPos_t(0);
+
+  CConfigHandler handler;
+  CIniReader reader(handler);
+  TEST_CHECK(reader.Parse_t(strm, 256));
+  fclose(strm.strm_pFile);
+
+  // Both parsers read the same keys
+  IniStr strExpected, strResult;
+  ini.Write(strExpected);
+  handler.m_ini.Write(strResult);
+
+  TEST_CHECK(strResult == strExpected);
+  TEST_CHECK(handler.m_ini.GetValue("Data", "Blob").Length() == 20000);
+  TEST_CHECK(handler.m_ini.GetIntValue("Data", "After", 0) == 2);
+};
+
+static void TestStopping(void) {
+  const IniStr strText = "A = 1\nB = 2\nC = 3\n";
+
+  CLogHandler handler;
+  handler.m_ctStopAfter = 2;
+
+  CIniReader reader(handler);
+  TEST_CHECK(!reader.Parse(strText.c_str(), strText.c_str() + strText.length()));
+  TEST_CHECK(reader.IsStopped() && handler.m_strLog == "/A=1\n/B=2\n");
+};
+
+static void TestFiles(void) {
+  FILE *pFile = fopen("IniReaderTest.ini", "wb");
+  fputs("[Game]\nSpeed = 5\n", pFile);
+  fclose(pFile);
+
+  // Both file loaders give the same result
+  CLogHandler handlerStock, handlerEngine;
+  CIniReader readerStock(handlerStock), readerEngine(handlerEngine);
+
+  TEST_CHECK(readerStock.ParseFile_t("IniReaderTest.ini", false, 16));
+  TEST_CHECK(readerEngine.ParseFile_t("IniReaderTest.ini", true, 16));
+  TEST_CHECK(handlerStock.m_strLog == "[Game]\nGame/Speed=5\n<end>\n");
+  TEST_CHECK(handlerEngine.m_strLog == handlerStock.m_strLog);
+
+  remove("IniReaderTest.ini");
+
+  // Missing files throw errors
+  bool bThrown = false;
+
+  try {
+    readerStock.ParseFile_t("IniReaderTest.ini", false);
+  } catch (char *strError) {
+    free(strError);
+    bThrown = true;
+  }
+
+  TEST_CHECK(bThrown);
+};
+
+int main() {
+  TestLines();
+  TestRandomChunks();
+  TestLongLines();
+  TestStopping();
+  TestFiles();
+
+  return TestResult("IniReaderTest");
+};
@@ -0,0 +1,85 @@
+/* Copyright (c) 2026 Dreamy Cecil
+This program is free software; you can redistribute it and/or modify
+it under the terms of version 2 of the GNU General Public License as published by
+the Free Software Foundation
+
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License along
+with this program; if not, write to the Free Software Foundation, Inc.,
+51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA. */
+
+// Checks of CIniFileWatcher
+// g++ -O1 -I Tests/Stubs Tests/IniWatcherTest.cpp -o IniWatcherTest
+
+#include "TestCommon.h"
+
+#include "../Base/IniWatcher.h"
+
+static const char *_strTestFile = "IniWatcherTest.ini";
+static const char *_strTestSave = "IniWatcherTest_Save.ini";
+
+// Replace contents of the test file
+static void WriteTestFile(const char *strText) {
+  FILE *pFile = fopen(_strTestFile, "wb");
+  fwrite(strText, 1, strlen(strText), pFile);
+  fclose(pFile);
+};
+
+static void TestSameSizeEdits(void) {
+  WriteTestFile("[Game]\nSpeed = 1\n");
+
+  CIniConfig ini;
+  ini.Load_t(_strTestFile, false);
+
+  CIniFileWatcher watcher;
+  watcher.Watch(_strTestFile, false);
+
+  // Nothing has changed yet
+  TEST_CHECK(watcher.Poll_t(ini) == 0);
+
+  // Edits of the same size right after each other may keep the same modification time
+  WriteTestFile("[Game]\nSpeed = 2\n");
+  TEST_CHECK(watcher.Poll_t(ini) == 1);
+  TEST_CHECK(ini.GetIntValue("Game", "Speed", 0) == 2);
+
+  WriteTestFile("[Game]\nSpeed = 3\n");
+  TEST_CHECK(watcher.Poll_t(ini) == 1);
+  TEST_CHECK(ini.GetIntValue("Game", "Speed", 0) == 3);
+
+  TEST_CHECK(watcher.Poll_t(ini) == 0);
+
+  watcher.Stop();
+  TEST_CHECK(!watcher.CheckFile());
+};
+
+static void TestNewEmptySection(void) {
+  CIniConfig ini;
+  ini.Read("[Game]\nSpeed = 1\n");
+  TEST_CHECK(ini.SaveChanges_t(_strTestSave, false));
+  TEST_CHECK(!ini.SaveChanges_t(_strTestSave, false));
+
+  // Added section without keys still has to be saved
+  CIniConfig iniNew;
+  iniNew.Read("[Game]\nSpeed = 1\n[Empty]\nKey = 1\n");
+  iniNew.Delete("Empty", "Key");
+  TEST_CHECK(iniNew.SectionExists("Empty"));
+
+  ini.Update(iniNew);
+  TEST_CHECK(ini.SectionExists("Empty"));
+  TEST_CHECK(ini.SaveChanges_t(_strTestSave, false));
+};
+
+int main() {
+  TestSameSizeEdits();
+  TestNewEmptySection();
+
+  remove(_strTestFile);
+  remove(_strTestSave);
+
+  return TestResult("IniWatcherTest");
+};
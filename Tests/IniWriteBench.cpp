@@ -0,0 +1,133 @@
+/* Copyright (c) 2026 Dreamy Cecil
+This program is free software; you can redistribute it and/or modify
+it under the terms of version 2 of the GNU General Public License as published by
+the Free Software Foundation
+
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License along
+with this program; if not, write to the Free Software Foundation, Inc.,
+51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA. */
+
+// Writing benchmark of configs against the string stream writer that it used to have
+// g++ -O2 -DNDEBUG -I Tests/Stubs Tests/IniWriteBench.cpp -o IniWriteBench
+
+#include "TestCommon.h"
+
+#include <sstream>
+#include "../Base/IniConfig.h"
+
+static const char *_strBenchFile = "IniWriteBench.ini";
+
+// Previous writer that printed everything into a string stream
+static void WriteWithStream(const CIniConfig &ini, IniStr &str) {
+  std::ostringstream strm;
+  const IniSections &sections = ini.GetMap();
+
+  for (IniSections::const_iterator it = sections.begin(); it != sections.end(); it++) {
+    if (it->first != "") {
+      strm << '[' << it->first << "]\n";
+    }
+
+    const IniKeys &pairs = it->second;
+
+    for (IniKeys::const_iterator itPair = pairs.begin(); itPair != pairs.end(); itPair++) {
+      const CIniText &strValue = itPair->second.GetText();
+      const size_t ctValue = strValue.length();
+
+      // Find spaces on either end
+      const size_t iBegSpace = strcspn(strValue.c_str(), " \t");
+      size_t iEndSpace = ctValue;
+
+      for (size_t i = ctValue; i > 0; i--) {
+        if (strValue[i - 1] == ' ' || strValue[i - 1] == '\t') {
+          iEndSpace = i - 1;
+          break;
+        }
+      }
+
+      // Surround with quotes if there's a space on either end
+      if (ctValue != 0 && (iBegSpace == 0 || iEndSpace == ctValue - 1)) {
+        strm << itPair->first.c_str() << " = \"" << strValue.c_str() << "\"\n";
+      } else {
+        strm << itPair->first.c_str() << " = " << strValue.c_str() << '\n';
+      }
+    }
+  }
+
+  str = strm.str();
+};
+
+// Generate a config of about 250 KB
+static void MakeConfig(CIniConfig &ini) {
+  char strSection[64], strKey[64], strValue[64];
+
+  for (ULONG iSection = 0; iSection < 50; iSection++) {
+    sprintf(strSection, "Section_%u", iSection);
+
+    for (ULONG iKey = 0; iKey < 100; iKey++) {
+      sprintf(strKey, "Some_Key_Name_%u", iKey);
+      sprintf(strValue, (iKey % 10 == 0) ? " Spaced value %u " : "Value of the key %u", iKey * 31);
+      ini.SetValue(strSection, strKey, strValue);
+    }
+  }
+};
+
+int main() {
+  CIniConfig ini;
+  MakeConfig(ini);
+
+  IniStr strOld, strNew;
+  WriteWithStream(ini, strOld);
+  ini.Write(strNew);
+
+  printf("config: %u bytes, same output: %s\n", (ULONG)strNew.length(), (strOld == strNew) ? "yes" : "NO");
+
+  const INDEX ctRounds = 200;
+  double dStart = TestSeconds();
+
+  for (INDEX i = 0; i < ctRounds; i++) {
+    WriteWithStream(ini, strOld);
+    _iTestSink += strOld.length();
+  }
+
+  const double dStream = (TestSeconds() - dStart) * 1e3 / ctRounds;
+  dStart = TestSeconds();
+
+  for (INDEX i = 0; i < ctRounds; i++) {
+    ini.Write(strNew);
+    _iTestSink += strNew.length();
+  }
+
+  const double dWrite = (TestSeconds() - dStart) * 1e3 / ctRounds;
+
+  printf("Write():        stream %.3f ms, single buffer %.3f ms\n", dStream, dWrite);
+
+  // Autosaves after changing one key
+  dStart = TestSeconds();
+
+  for (INDEX i = 0; i < ctRounds; i++) {
+    ini.SetIntValue("Section_25", "Some_Key_Name_50", i);
+    ini.Save_t(_strBenchFile);
+  }
+
+  const double dSave = (TestSeconds() - dStart) * 1e3 / ctRounds;
+  ini.SaveChanges_t(_strBenchFile, false);
+  dStart = TestSeconds();
+
+  for (INDEX i = 0; i < ctRounds; i++) {
+    ini.SetIntValue("Section_25", "Some_Key_Name_50", i);
+    ini.SaveChanges_t(_strBenchFile, false);
+  }
+
+  const double dSaveChanges = (TestSeconds() - dStart) * 1e3 / ctRounds;
+
+  printf("Autosave:       Save_t() %.3f ms, SaveChanges_t() %.3f ms\n", dSave, dSaveChanges);
+
+  remove(_strBenchFile);
+  return 0;
+};
@@ -0,0 +1,90 @@
+/* Copyright (c) 2026 Dreamy Cecil
+This program is free software; you can redistribute it and/or modify
+it under the terms of version 2 of the GNU General Public License as published by
+the Free Software Foundation
+
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License along
+with this program; if not, write to the Free Software Foundation, Inc.,
+51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA. */
+
+// Lookup benchmark of se1::map against the plain list that it used to be
+// g++ -O2 -DNDEBUG -I Tests/Stubs Tests/MapStructureBench.cpp -o MapStructureBench
+
+#include "TestCommon.h"
+
+#include <vector>
+#include "../Objects/MapStructure.h"
+
+// Previous implementation of se1::map that searched through the list
+template<class _T1, class _T2>
+class ListMap : public std::list<std::pair<_T1, _T2> > {
+  public:
+    typedef std::pair<_T1, _T2> value_type;
+    typedef std::list<value_type> _Myt;
+    typedef typename _Myt::iterator iterator;
+
+    iterator find(const _T1 &key) {
+      for (iterator it = this->begin(); it != this->end(); it++) {
+        if (it->first == key) return it;
+      }
+      return this->end();
+    };
+
+    void insert(const value_type &pair) {
+      if (find(pair.first) == this->end()) this->push_back(pair);
+    };
+};
+
+// Measure average time of one lookup in nanoseconds
+// The same amount of lookups is made for every map size, so every key isn't necessarily looked up in big maps.
+template<class Map>
+double MeasureLookups(const std::vector<std::string> &aKeys, size_t ctLookups) {
+  const size_t ctKeys = aKeys.size();
+  Map map;
+
+  for (size_t iKey = 0; iKey < ctKeys; iKey++) {
+    map.insert(typename Map::value_type(aKeys[iKey], iKey));
+  }
+
+  const double dStart = TestSeconds();
+
+  for (size_t i = 0; i < ctLookups; i++) {
+    // Spread lookups across the map
+    _iTestSink += map.find(aKeys[(i * 7919) % ctKeys])->second;
+  }
+
+  return (TestSeconds() - dStart) * 1e9 / (double)ctLookups;
+};
+
+int main() {
+  static const size_t aSizes[3] = { 10, 1000, 100000 };
+
+  printf("%8s %8s %16s %16s %8s\n", "keys", "lookups", "list (ns/find)", "hashed (ns/find)", "speedup");
+
+  for (int iSize = 0; iSize < 3; iSize++) {
+    const size_t ctKeys = aSizes[iSize];
+    std::vector<std::string> aKeys;
+
+    for (size_t iKey = 0; iKey < ctKeys; iKey++) {
+      char strKey[32];
+      sprintf(strKey, "section_key_%u", (ULONG)iKey);
+      aKeys.push_back(strKey);
+    }
+
+    // Lookups in the list take long enough with 100k keys
+    const size_t ctLookups = (ctKeys <= 1000) ? 1000000 : 20000;
+
+    const double dList = MeasureLookups< ListMap<std::string, size_t> >(aKeys, ctLookups);
+    const double dHashed = MeasureLookups< se1::map<std::string, size_t> >(aKeys, ctLookups);
+
+    printf("%8u %8u %16.1f %16.1f %7.1fx\n", (ULONG)ctKeys, (ULONG)ctLookups, dList, dHashed, dList / dHashed);
+  }
+
+  return 0;
+};
@@ -0,0 +1,257 @@
+/* Copyright (c) 2026 Dreamy Cecil
+This program is free software; you can redistribute it and/or modify
+it under the terms of version 2 of the GNU General Public License as published by
+the Free Software Foundation
+
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License along
+with this program; if not, write to the Free Software Foundation, Inc.,
+51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA. */
+
+// Checks of se1::map against std::map and std::list
+// g++ -O1 -I Tests/Stubs Tests/MapStructureTest.cpp -o MapStructureTest
+
+#include "TestCommon.h"
+
+#include <map>
+#include <list>
+#include "../Objects/MapStructure.h"
+
+typedef se1::map<std::string, int> StrMap;
+
+// Key type without a hash function
+struct NoHashKey {
+  int iValue;
+
+  NoHashKey(int i = 0) : iValue(i) {};
+  bool operator==(const NoHashKey &other) const { return iValue == other.iValue; };
+};
+
+enum EKey { E_KEY_A, E_KEY_B, E_KEY_C };
+
+// Check that every key in the map can be found and leads to the first pair under it
+template<class Map>
+bool FirstPairsFound(Map &map) {
+  for (typename Map::iterator it = map.begin(); it != map.end(); ++it) {
+    typename Map::iterator itFirst = map.begin();
+    while (!(itFirst->first == it->first)) ++itFirst;
+
+    if (map.find(it->first) != itFirst) return false;
+  }
+  return true;
+};
+
+static void TestRandomOperations(void) {
+  srand(1);
+
+  for (int iRun = 0; iRun < 200; iRun++) {
+    StrMap map;
+    std::map<std::string, int> mapRef;
+    const int ctKeys = 1 + iRun * 3;
+
+    for (int iStep = 0; iStep < 2000; iStep++) {
+      char strKey[16];
+      sprintf(strKey, "key%d", rand() % ctKeys);
+
+      switch (rand() % 3) {
+        case 0: map[strKey] = iStep; mapRef[strKey] = iStep; break;
+
+        case 1: {
+          StrMap::iterator it = map.find(strKey);
+          if (it != map.end()) map.erase(it);
+          mapRef.erase(strKey);
+        } break;
+
+        default: {
+          StrMap::const_iterator it = ((const StrMap &)map).find(strKey);
+          std::map<std::string, int>::iterator itRef = mapRef.find(strKey);
+
+          TEST_CHECK((it == map.end()) == (itRef == mapRef.end()));
+          if (it != map.end() && itRef != mapRef.end()) TEST_CHECK(it->second == itRef->second);
+        }
+      }
+    }
+
+    TEST_CHECK(map.size() == mapRef.size());
+
+    // Copies must be searchable as well
+    StrMap mapCopy(map);
+    std::map<std::string, int>::iterator itRef;
+
+    for (itRef = mapRef.begin(); itRef != mapRef.end(); ++itRef) {
+      TEST_CHECK(mapCopy.count(itRef->first) == 1 && mapCopy.at(itRef->first) == itRef->second);
+    }
+  }
+};
+
+static void TestOrder(void) {
+  StrMap map;
+  char strKey[16];
+
+  for (int i = 0; i < 100; i++) {
+    sprintf(strKey, "%d", 99 - i);
+    map[strKey] = i;
+  }
+
+  // Pairs stay in the order of insertion
+  int iExpected = 0;
+  for (StrMap::iterator it = map.begin(); it != map.end(); ++it) {
+    TEST_CHECK(it->second == iExpected++);
+  }
+
+  TEST_CHECK(!map.insert(StrMap::value_type("50", -1)).second);
+  TEST_CHECK(map["50"] == 49);
+};
+
+static void TestListInterface(void) {
+  StrMap map;
+  char strKey[16];
+
+  for (int i = 0; i < 20; i++) {
+    sprintf(strKey, "%d", i);
+    map.push_back(StrMap::value_type(strKey, i));
+  }
+
+  // Duplicate key at the end keeps the first pair
+  map.push_back(StrMap::value_type("5", 100));
+  TEST_CHECK(map.size() == 21 && map.find("5")->second == 5);
+
+  // Duplicate key at the front takes over
+  map.push_front(StrMap::value_type("5", 200));
+  TEST_CHECK(map.find("5")->second == 200);
+  TEST_CHECK(FirstPairsFound(map));
+
+  // Removing the first pair makes the next one under the same key visible
+  map.pop_front();
+  TEST_CHECK(map.find("5")->second == 5);
+  map.erase(map.find("5"));
+  TEST_CHECK(map.find("5")->second == 100);
+  TEST_CHECK(FirstPairsFound(map));
+
+  // Insertion in the middle
+  StrMap::iterator itWhere = map.find("10");
+  map.insert(itWhere, StrMap::value_type("new", -1));
+  TEST_CHECK(map.find("new")->second == -1);
+  TEST_CHECK((--map.find("10"))->first == "new");
+
+  map.remove(StrMap::value_type("new", -1));
+  TEST_CHECK(map.find("new") == map.end());
+
+  map.remove_if(std::bind2nd(std::not_equal_to<StrMap::value_type>(), StrMap::value_type("3", 3)));
+  TEST_CHECK(map.size() == 1 && map.find("3") != map.end() && map.find("4") == map.end());
+
+  // Sorting and reversing reorders duplicates
+  map.clear();
+
+  for (int i = 0; i < 30; i++) {
+    sprintf(strKey, "%d", i % 15);
+    map.push_back(StrMap::value_type(strKey, i));
+  }
+
+  map.sort();
+  TEST_CHECK(map.find("7")->second == 7);
+  map.reverse();
+  TEST_CHECK(map.find("7")->second == 22);
+  TEST_CHECK(FirstPairsFound(map));
+
+  map.resize(10);
+  TEST_CHECK(map.size() == 10 && FirstPairsFound(map));
+
+  map.assign(12, StrMap::value_type("same", 1));
+  map.unique();
+  TEST_CHECK(map.size() == 1 && map.find("same") != map.end());
+
+  // Moving pairs between maps
+  StrMap map1, map2;
+
+  for (int i = 0; i < 20; i++) {
+    sprintf(strKey, "a%d", i);
+    map1.push_back(StrMap::value_type(strKey, i));
+    sprintf(strKey, "b%d", i);
+    map2.push_back(StrMap::value_type(strKey, i));
+  }
+
+  map1.splice(map1.begin(), map2, map2.find("b7"));
+  TEST_CHECK(map1.size() == 21 && map2.size() == 19);
+  TEST_CHECK(map1.find("b7") == map1.begin() && map2.find("b7") == map2.end());
+
+  map1.splice(map1.end(), map2, map2.begin(), map2.find("b10"));
+  TEST_CHECK(map1.find("b9") != map1.end() && map2.find("b9") == map2.end() && map2.find("b10") == map2.begin());
+
+  map1.splice(map1.end(), map2);
+  TEST_CHECK(map2.empty() && map1.size() == 40 && map1.find("b19") != map1.end());
+  TEST_CHECK(FirstPairsFound(map1));
+
+  map1.sort();
+  map2.push_back(StrMap::value_type("a5", -5));
+  map2.push_back(StrMap::value_type("c", 0));
+  map1.merge(map2);
+  TEST_CHECK(map2.empty() && map1.size() == 42 && map1.find("c") != map1.end());
+  TEST_CHECK(FirstPairsFound(map1));
+
+  // Comparison
+  StrMap mapCopy(map1);
+  TEST_CHECK(mapCopy == map1);
+  mapCopy.pop_back();
+  TEST_CHECK(mapCopy != map1);
+};
+
+static void TestKeyTypes(void) {
+  // Keys without hash functions are searched linearly
+  se1::map<NoHashKey, int> mapNoHash;
+  se1::map<EKey, int> mapEnum;
+  TEST_CHECK(!se1::map_hash_used< se1::map_hash<NoHashKey> >::value);
+  TEST_CHECK(se1::map_hash_used< se1::map_hash<int> >::value);
+
+  for (int i = 0; i < 100; i++) {
+    mapNoHash[NoHashKey(i)] = i;
+  }
+
+  mapNoHash.erase(mapNoHash.find(NoHashKey(50)));
+  TEST_CHECK(mapNoHash.find(NoHashKey(50)) == mapNoHash.end() && mapNoHash.at(NoHashKey(99)) == 99);
+
+  mapEnum[E_KEY_B] = 1;
+  mapEnum[E_KEY_C] = 2;
+  TEST_CHECK(mapEnum.at(E_KEY_C) == 2 && mapEnum.find(E_KEY_A) == mapEnum.end());
+
+  // Other hashed types
+  se1::map<__int64, int> map64;
+  se1::map<float, int> mapFloat;
+  se1::map<const void *, int> mapPtr;
+
+  for (int i = 0; i < 100; i++) {
+    map64[(__int64)i << 32] = i;
+    mapFloat[i * 0.5f] = i;
+    mapPtr[&map64 + i] = i;
+  }
+
+  TEST_CHECK(map64.size() == 100 && map64.at((__int64)77 << 32) == 77);
+  TEST_CHECK(mapFloat.at(-0.0f) == 0 && mapFloat.at(12.5f) == 25);
+  TEST_CHECK(mapPtr.at(&map64 + 42) == 42);
+
+  // Engine strings are case-insensitive
+  se1::map<CTString, int> mapStr;
+  se1::map<CTFileName, int> mapFile;
+
+  for (int i = 0; i < 100; i++) {
+    mapStr[CTString(0, "Key%d", i)] = i;
+    mapFile[CTFileName(CTString(0, "Data\\File%d.txt", i))] = i;
+  }
+
+  TEST_CHECK(mapStr.at(CTString("KEY42")) == 42 && mapStr.size() == 100);
+  TEST_CHECK(mapFile.at(CTFileName("data\\FILE7.TXT")) == 7);
+};
+
+int main() {
+  TestRandomOperations();
+  TestOrder();
+  TestListInterface();
+  TestKeyTypes();
+
+  return TestResult("MapStructureTest");
+};
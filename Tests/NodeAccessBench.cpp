@@ -0,0 +1,96 @@
+/* Copyright (c) 2026 Dreamy Cecil
+This program is free software; you can redistribute it and/or modify
+it under the terms of version 2 of the GNU General Public License as published by
+the Free Software Foundation
+
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License along
+with this program; if not, write to the Free Software Foundation, Inc.,
+51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA. */
+
+// Benchmark of counting and accessing CNode children against walking through them
+// g++ -O2 -DNDEBUG -I Tests/Stubs Tests/NodeAccessBench.cpp -o NodeAccessBench
+
+#include "TestCommon.h"
+
+#include <vector>
+#include "../Objects/Node.h"
+
+// Count children by walking through the chain, like before the counter
+static size_t CountByWalking(const CNode &node) {
+  size_t ct = 0;
+
+  for (const CNode *pNode = node.GetHead(); pNode != NULL; pNode = pNode->GetNext()) {
+    ct++;
+  }
+
+  return ct;
+};
+
+// Measure average time of counting children in nanoseconds
+static double MeasureCounts(const CNode &node, bool bWalk, size_t ctCounts) {
+  const double dStart = TestSeconds();
+
+  for (size_t i = 0; i < ctCounts; i++) {
+    _iTestSink += bWalk ? CountByWalking(node) : node.GetNodeCount();
+  }
+
+  return (TestSeconds() - dStart) * 1e9 / (double)ctCounts;
+};
+
+// Get an n-th child by walking from the beginning, like before the index
+static CNode *GetByWalking(const CNode &node, size_t n) {
+  CNode *pNode = node.GetHead();
+
+  for (; pNode != NULL && n != 0; --n) pNode = pNode->GetNext();
+
+  return pNode;
+};
+
+// Measure average time of getting every child by its position in a loop in milliseconds
+static double MeasureLoops(const CNode &node, bool bWalk, size_t ctLoops) {
+  const size_t ct = node.GetNodeCount();
+  const double dStart = TestSeconds();
+
+  for (size_t iLoop = 0; iLoop < ctLoops; iLoop++) {
+    for (size_t i = 0; i < ct; i++) {
+      _iTestSink += (size_t)(bWalk ? GetByWalking(node, i) : node.GetNode(i));
+    }
+  }
+
+  return (TestSeconds() - dStart) * 1e3 / (double)ctLoops;
+};
+
+int main() {
+  std::vector<CNode> aNodes(5000);
+  CNode node;
+
+  for (size_t i = 0; i < aNodes.size(); i++) node.AddTail(&aNodes[i]);
+
+  const double dWalk = MeasureCounts(node, true, 20000);
+  const double dCounter = MeasureCounts(node, false, 20000000);
+
+  printf("counting %u children: walking %.2f ns, counter %.2f ns\n", (ULONG)aNodes.size(), dWalk, dCounter);
+
+  // Access every child of a list like a list widget does
+  std::vector<CNode> aItems(3000);
+  CNode nodeList;
+
+  for (size_t i = 0; i < aItems.size(); i++) nodeList.AddTail(&aItems[i]);
+
+  const double dLinear = MeasureLoops(nodeList, true, 20);
+  const double dCloser = MeasureLoops(nodeList, false, 20);
+
+  nodeList.SetIndexed(true);
+  const double dIndexed = MeasureLoops(nodeList, false, 2000);
+
+  printf("GetNode(i) loop over %u children: linear %.3f ms, closer end %.3f ms, indexed %.3f ms\n",
+    (ULONG)aItems.size(), dLinear, dCloser, dIndexed);
+
+  return 0;
+};
@@ -0,0 +1,111 @@
+/* Copyright (c) 2026 Dreamy Cecil
+This program is free software; you can redistribute it and/or modify
+it under the terms of version 2 of the GNU General Public License as published by
+the Free Software Foundation
+
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License along
+with this program; if not, write to the Free Software Foundation, Inc.,
+51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA. */
+
+// Sorting benchmark of CNode children against sorting them in a temporary array and reinserting them
+// g++ -O2 -DNDEBUG -I Tests/Stubs Tests/NodeSortBench.cpp -o NodeSortBench
+
+#include "TestCommon.h"
+
+#include <algorithm>
+#include <vector>
+#include "../Objects/Node.h"
+
+class CDepthNode : public CNode {
+  public:
+    INDEX m_iDepth;
+};
+
+static bool CompareDepth(const CNode *pNode1, const CNode *pNode2) {
+  return ((const CDepthNode *)pNode1)->m_iDepth < ((const CDepthNode *)pNode2)->m_iDepth;
+};
+
+// Sort children by copying them into an array and reinserting them in order
+static void SortByReinserting(CNode &node) {
+  std::vector<CNode *> apNodes;
+  apNodes.reserve(node.GetNodeCount());
+
+  for (CNode *pNode = node.GetHead(); pNode != NULL; pNode = pNode->GetNext()) {
+    apNodes.push_back(pNode);
+  }
+
+  std::stable_sort(apNodes.begin(), apNodes.end(), CompareDepth);
+
+  for (size_t i = 0; i < apNodes.size(); i++) {
+    apNodes[i]->Expunge();
+    node.AddTail(apNodes[i]);
+  }
+};
+
+// Change depths of all nodes (either all of them or only a few, like between frames)
+static void ShuffleDepths(std::vector<CDepthNode> &aNodes, bool bFew, ULONG &ulSeed) {
+  for (size_t i = 0; i < aNodes.size(); i++) {
+    ulSeed = ulSeed * 1664525UL + 1013904223UL;
+    if (bFew && (ulSeed >> 24) % 20 != 0) continue;
+
+    aNodes[i].m_iDepth = (ulSeed >> 8) % 100000;
+  }
+};
+
+// Measure average time of sorting a list of nodes in microseconds
+static double MeasureSort(size_t ctNodes, bool bFew, bool bReinsert, size_t ctSorts) {
+  std::vector<CDepthNode> aNodes(ctNodes);
+  CNode node;
+
+  for (size_t i = 0; i < ctNodes; i++) node.AddTail(&aNodes[i]);
+
+  ULONG ulSeed = 1;
+  ShuffleDepths(aNodes, false, ulSeed);
+  node.SortChildren(CompareDepth);
+
+  double dTotal = 0.0;
+
+  for (size_t iSort = 0; iSort < ctSorts; iSort++) {
+    ShuffleDepths(aNodes, bFew, ulSeed);
+
+    const double dStart = TestSeconds();
+
+    if (bReinsert) {
+      SortByReinserting(node);
+    } else {
+      node.SortChildren(CompareDepth);
+    }
+
+    dTotal += TestSeconds() - dStart;
+    _iTestSink += ((CDepthNode *)node.GetHead())->m_iDepth;
+  }
+
+  while (node.GetHead() != NULL) node.GetHead()->Expunge();
+  return dTotal * 1e6 / (double)ctSorts;
+};
+
+int main() {
+  static const size_t aSizes[4] = { 100, 1000, 10000, 100000 };
+
+  printf("%8s %10s %18s %18s\n", "nodes", "changed", "reinsert (us)", "SortChildren (us)");
+
+  for (int iSize = 0; iSize < 4; iSize++) {
+    const size_t ctNodes = aSizes[iSize];
+    const size_t ctSorts = (ctNodes <= 1000) ? 2000 : (ctNodes <= 10000) ? 200 : 20;
+
+    for (int iFew = 1; iFew >= 0; iFew--) {
+      const double dReinsert = MeasureSort(ctNodes, iFew != 0, true, ctSorts);
+      const double dSort = MeasureSort(ctNodes, iFew != 0, false, ctSorts);
+
+      printf("%8u %10s %18.2f %18.2f\n", (ULONG)ctNodes, iFew ? "5%" : "all", dReinsert, dSort);
+    }
+  }
+
+  return 0;
+};
@@ -0,0 +1,100 @@
+/* Copyright (c) 2026 Dreamy Cecil
+This program is free software; you can redistribute it and/or modify
+it under the terms of version 2 of the GNU General Public License as published by
+the Free Software Foundation
+
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License along
+with this program; if not, write to the Free Software Foundation, Inc.,
+51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA. */
+
+// Checks of sorting CNode children
+// g++ -O1 -I Tests/Stubs Tests/NodeSortTest.cpp -o NodeSortTest
+
+#include "TestCommon.h"
+
+#include <vector>
+#include "../Objects/Node.h"
+
+// Node with a sorting key and its original position
+class CDepthNode : public CNode {
+  public:
+    INDEX m_iDepth;
+    INDEX m_iOrder;
+
+    CDepthNode(INDEX iDepth = 0, INDEX iOrder = 0) : m_iDepth(iDepth), m_iOrder(iOrder) {};
+};
+
+static bool CompareDepth(const CNode *pNode1, const CNode *pNode2) {
+  return ((const CDepthNode *)pNode1)->m_iDepth < ((const CDepthNode *)pNode2)->m_iDepth;
+};
+
+// Check that children are ordered by depth, nodes with the same depth keep their order and links are consistent
+static bool IsSorted(const CNode &node) {
+  const CDepthNode *pPrev = NULL;
+  size_t ctNodes = 0;
+
+  for (const CNode *pNode = node.GetHead(); pNode != NULL; pNode = pNode->GetNext()) {
+    const CDepthNode *pDepth = (const CDepthNode *)pNode;
+
+    if (pNode->GetPrev() != pPrev || pNode->GetParent() != &node) return false;
+
+    if (pPrev != NULL) {
+      if (pPrev->m_iDepth > pDepth->m_iDepth) return false;
+      if (pPrev->m_iDepth == pDepth->m_iDepth && pPrev->m_iOrder > pDepth->m_iOrder) return false;
+    }
+
+    pPrev = pDepth;
+    ctNodes++;
+  }
+
+  return node.GetTail() == pPrev && ctNodes == node.GetNodeCount();
+};
+
+static void TestSort(INDEX ctNodes, INDEX iPattern) {
+  std::vector<CDepthNode> aNodes(ctNodes);
+  CNode node;
+
+  for (INDEX i = 0; i < ctNodes; i++) {
+    INDEX iDepth;
+
+    switch (iPattern) {
+      case 0: iDepth = i; break; // Sorted
+      case 1: iDepth = ctNodes - i; break; // Reversed
+      case 2: iDepth = (i * 7919) % 13; break; // Many equal keys
+      default: iDepth = (i % 10 == 0) ? -i : i; break; // Nearly sorted
+    }
+
+    aNodes[i].m_iDepth = iDepth;
+    aNodes[i].m_iOrder = i;
+    node.AddTail(&aNodes[i]);
+  }
+
+  node.SortChildren(CompareDepth);
+  TEST_CHECK(IsSorted(node));
+
+  // Random access is rebuilt after sorting
+  if (ctNodes > 0) {
+    TEST_CHECK(node.GetNode(ctNodes - 1) == node.GetTail());
+  }
+
+  // Children are released before the nodes themselves
+  while (node.GetHead() != NULL) node.GetHead()->Expunge();
+};
+
+int main() {
+  static const INDEX actNodes[6] = { 0, 1, 2, 3, 100, 1000 };
+
+  for (INDEX iCount = 0; iCount < 6; iCount++) {
+    for (INDEX iPattern = 0; iPattern < 4; iPattern++) {
+      TestSort(actNodes[iCount], iPattern);
+    }
+  }
+
+  return TestResult("NodeSortTest");
+};
@@ -0,0 +1,77 @@
+/* Copyright (c) 2026 Dreamy Cecil
+This program is free software; you can redistribute it and/or modify
+it under the terms of version 2 of the GNU General Public License as published by
+the Free Software Foundation
+
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License along
+with this program; if not, write to the Free Software Foundation, Inc.,
+51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA. */
+
+// Benchmark of moving CNode children to another parent at once against moving them one by one
+// g++ -O2 -DNDEBUG -I Tests/Stubs Tests/NodeSpliceBench.cpp -o NodeSpliceBench
+
+#include "TestCommon.h"
+
+#include <vector>
+#include "../Objects/Node.h"
+
+// Move all children to another parent one by one
+static void MoveByAdding(CNode &nodeFrom, CNode &nodeTo) {
+  while (nodeFrom.GetHead() != NULL) {
+    CNode *pNode = nodeFrom.GetHead();
+    pNode->Expunge();
+    nodeTo.AddTail(pNode);
+  }
+};
+
+// Measure average time of moving all children between two parents in microseconds
+static double MeasureMoves(size_t ctNodes, bool bSplice, size_t ctMoves) {
+  std::vector<CNode> aNodes(ctNodes);
+  CNode node1, node2;
+
+  for (size_t i = 0; i < ctNodes; i++) node1.AddTail(&aNodes[i]);
+
+  const double dStart = TestSeconds();
+
+  for (size_t iMove = 0; iMove < ctMoves; iMove++) {
+    CNode &nodeFrom = (iMove & 1) ? node2 : node1;
+    CNode &nodeTo = (iMove & 1) ? node1 : node2;
+
+    if (bSplice) {
+      nodeTo.TakeNodes(&nodeFrom);
+    } else {
+      MoveByAdding(nodeFrom, nodeTo);
+    }
+
+    _iTestSink += (size_t)nodeTo.GetTail();
+  }
+
+  const double dResult = (TestSeconds() - dStart) * 1e6 / (double)ctMoves;
+
+  // Make sure that nothing has been lost
+  if (node1.GetNodeCount() + node2.GetNodeCount() != ctNodes) printf("Lost nodes after moving them!\n");
+
+  return dResult;
+};
+
+int main() {
+  static const size_t aCounts[3] = { 1000, 20000, 100000 };
+
+  printf("%8s %18s %18s %8s\n", "nodes", "AddTail (us)", "TakeNodes (us)", "speedup");
+
+  for (int iSize = 0; iSize < 3; iSize++) {
+    const size_t ctMoves = 2000000 / aCounts[iSize];
+    const double dAdd = MeasureMoves(aCounts[iSize], false, ctMoves);
+    const double dSplice = MeasureMoves(aCounts[iSize], true, ctMoves);
+
+    printf("%8u %18.2f %18.2f %7.2fx\n", (ULONG)aCounts[iSize], dAdd, dSplice, dAdd / dSplice);
+  }
+
+  return 0;
+};
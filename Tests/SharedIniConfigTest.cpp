@@ -0,0 +1,158 @@
+/* Copyright (c) 2026 Dreamy Cecil
+This program is free software; you can redistribute it and/or modify
+it under the terms of version 2 of the GNU General Public License as published by
+the Free Software Foundation
+
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License along
+with this program; if not, write to the Free Software Foundation, Inc.,
+51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA. */
+
+// Checks of CSharedIniConfig with a writer thread and reader threads
+// Build it with a thread sanitizer to check that reading snapshots doesn't race with anything:
+// g++ -O1 -fsanitize=thread -I Tests/Stubs Tests/SharedIniConfigTest.cpp -o SharedIniConfigTest -lpthread
+
+#include "TestCommon.h"
+
+#include "../Base/SharedIniConfig.h"
+
+#ifdef _WIN32
+  typedef HANDLE TestThread;
+  #define TEST_THREAD_FUNC(_Name) DWORD WINAPI _Name(void *pArg)
+
+  static void StartThread(TestThread &th, LPTHREAD_START_ROUTINE pFunc, void *pArg) {
+    th = CreateThread(NULL, 0, pFunc, pArg, 0, NULL);
+  };
+
+  static void JoinThread(TestThread &th) {
+    WaitForSingleObject(th, INFINITE);
+    CloseHandle(th);
+  };
+
+#else
+  typedef pthread_t TestThread;
+  #define TEST_THREAD_FUNC(_Name) void *_Name(void *pArg)
+
+  static void StartThread(TestThread &th, void *(*pFunc)(void *), void *pArg) {
+    pthread_create(&th, NULL, pFunc, pArg);
+  };
+
+  static void JoinThread(TestThread &th) {
+    pthread_join(th, NULL);
+  };
+#endif
+
+static const char *_strTestSave = "SharedIniConfigTest_Save.ini";
+
+static CSharedIniConfig _iniShared(2);
+static volatile LONG _bWriterDone = FALSE;
+static volatile LONG _ctMismatches = 0;
+
+// Publish a series of configs with the same value under two keys
+static TEST_THREAD_FUNC(WriterThread) {
+  for (int i = 0; i < 2000; i++) {
+    CIniConfig *pNew = new CIniConfig;
+
+    char strValue[32];
+    sprintf(strValue, "%d", i);
+    pNew->SetValue("Section", "Key1", strValue);
+    pNew->SetValue("Section", "Key2", strValue);
+
+    _iniShared.Publish(pNew);
+
+    // Saving the published snapshot doesn't write anything into it while it's being read
+    if (i % 100 == 0) _iniShared.SaveChanges_t(_strTestSave, false);
+  }
+
+  InterlockedExchange(&_bWriterDone, TRUE);
+  return 0;
+};
+
+// Read typed values from the current snapshot in "frames"
+static TEST_THREAD_FUNC(ReaderThread) {
+  const INDEX iReader = (INDEX)(size_t)pArg;
+
+  while (!InterlockedCompareExchange(&_bWriterDone, FALSE, FALSE)) {
+    for (int i = 0; i < 10; i++) {
+      const CIniConfig &ini = _iniShared.Get();
+
+      // Both keys come from the same snapshot (the initial one has neither of them)
+      if (ini.GetIntValue("Section", "Key1", -1) != ini.GetIntValue("Section", "Key2", -1)) {
+        InterlockedIncrement(&_ctMismatches);
+      }
+
+      ini.GetDoubleValue("Section", "Key1", 0.0);
+      ini.GetBoolValue("Section", "Key2", false);
+    }
+
+    _iniShared.Quiesce(iReader);
+  }
+
+  return 0;
+};
+
+static void TestFrozenConfig(void) {
+  CIniConfig ini;
+  ini.Read("[A]\nInt = 5\nText = abc\n");
+  ini.Freeze();
+
+  // Reads of frozen configs don't count anything
+  TEST_CHECK(ini.IsFrozen());
+  TEST_CHECK(ini.GetIntValue("A", "Int", 0) == 5 && ini.GetIntValue("A", "Text", -1) == -1);
+  TEST_CHECK(ini.GetParseStats().ctParses == 0 && ini.GetParseStats().ctHits == 0);
+
+  // Every value is fully converted beforehand
+  TEST_CHECK(ini.FindValue("A", "Text")->IsFullyCached());
+};
+
+static void TestThreads(void) {
+  TestThread thWriter, athReaders[2];
+  StartThread(thWriter, WriterThread, NULL);
+
+  for (size_t iReader = 0; iReader < 2; iReader++) {
+    StartThread(athReaders[iReader], ReaderThread, (void *)iReader);
+  }
+
+  JoinThread(thWriter);
+  JoinThread(athReaders[0]);
+  JoinThread(athReaders[1]);
+
+  TEST_CHECK(_ctMismatches == 0);
+  TEST_CHECK(_iniShared.Get().GetIntValue("Section", "Key1", -1) == 1999);
+
+  // Every replaced snapshot can be deleted once all readers are quiescent
+  _iniShared.Quiesce(0);
+  _iniShared.Quiesce(1);
+  _iniShared.Collect();
+  TEST_CHECK(_iniShared.CountRetired() == 0);
+
+  // Snapshots are saved again only after publishing new ones
+  TEST_CHECK(_iniShared.SaveChanges_t(_strTestSave, false));
+  TEST_CHECK(!_iniShared.SaveChanges_t(_strTestSave, false));
+
+  CIniConfig iniSaved;
+  iniSaved.Load_t(_strTestSave, false);
+  TEST_CHECK(iniSaved.GetIntValue("Section", "Key2", -1) == 1999);
+
+  CIniConfig *pNew = new CIniConfig;
+  pNew->SetValue("Section", "Key1", "last");
+  _iniShared.Publish(pNew);
+
+  TEST_CHECK(_iniShared.SaveChanges_t(_strTestSave, false));
+  iniSaved.Load_t(_strTestSave, false);
+  TEST_CHECK(iniSaved.GetValue("Section", "Key1") == "last");
+
+  remove(_strTestSave);
+};
+
+int main() {
+  TestFrozenConfig();
+  TestThreads();
+
+  return TestResult("SharedIniConfigTest");
+};
@@ -0,0 +1,87 @@
+/* Copyright (c) 2026 Dreamy Cecil
+This program is free software; you can redistribute it and/or modify
+it under the terms of version 2 of the GNU General Public License as published by
+the Free Software Foundation
+
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License along
+with this program; if not, write to the Free Software Foundation, Inc.,
+51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA. */
+
+// Number formatting benchmark of CStringBuilder against formatting with printf
+// g++ -O2 -DNDEBUG -I Tests/Stubs Tests/StringBuilderBench.cpp -o StringBuilderBench
+
+#include "TestCommon.h"
+
+#include <vector>
+#include "../Base/StringBuilder.h"
+
+// Previous formatting of doubles that tried more and more digits until the number was read back the same way
+static size_t FormatDoubleLoop(char *pchOut, DOUBLE d) {
+  for (int iDigits = 15; iDigits < 17; iDigits++) {
+    const size_t ct = sprintf(pchOut, "%.*g", iDigits, d);
+    if (strtod(pchOut, NULL) == d) return ct;
+  }
+
+  return sprintf(pchOut, "%.17g", d);
+};
+
+// Formatting with "%g" and 6 digits, which isn't read back exactly
+static size_t FormatDoubleG(char *pchOut, DOUBLE d) {
+  return sprintf(pchOut, "%g", d);
+};
+
+typedef size_t (*FFormatDouble)(char *pchOut, DOUBLE d);
+
+// Measure average time of formatting one number in nanoseconds
+static double MeasureFormat(FFormatDouble pFormat, const std::vector<DOUBLE> &aNumbers, size_t ctRepeats) {
+  char aBuffer[CStringBuilder::NUMBER_SIZE];
+  const double dStart = TestSeconds();
+
+  for (size_t iRepeat = 0; iRepeat < ctRepeats; iRepeat++) {
+    for (size_t i = 0; i < aNumbers.size(); i++) {
+      _iTestSink += pFormat(aBuffer, aNumbers[i]);
+    }
+  }
+
+  return (TestSeconds() - dStart) * 1e9 / double(ctRepeats * aNumbers.size());
+};
+
+int main() {
+  static const char *astrSets[3] = { "short", "thirds", "random" };
+
+  printf("%8s %16s %16s %16s\n", "numbers", "%g (ns)", "%.Ng loop (ns)", "builder (ns)");
+
+  for (int iSet = 0; iSet < 3; iSet++) {
+    std::vector<DOUBLE> aNumbers;
+    srand(iSet);
+
+    for (size_t i = 0; i < 4096; i++) {
+      const DOUBLE dRandom = DOUBLE(rand()) / DOUBLE(RAND_MAX);
+
+      switch (iSet) {
+        // Numbers with few digits like in configs
+        case 0: aNumbers.push_back(DOUBLE(rand() % 100000) / 100.0); break;
+
+        // Numbers that need 16 digits
+        case 1: aNumbers.push_back(DOUBLE(rand() % 1000) / 3.0 + 0.001); break;
+
+        // Numbers that mostly need all 17 digits
+        default: aNumbers.push_back(dRandom * pow(10.0, rand() % 40 - 20)); break;
+      }
+    }
+
+    const double dG = MeasureFormat(&FormatDoubleG, aNumbers, 200);
+    const double dLoop = MeasureFormat(&FormatDoubleLoop, aNumbers, 200);
+    const double dBuilder = MeasureFormat(&CStringBuilder::FormatDouble, aNumbers, 200);
+
+    printf("%8s %16.1f %16.1f %16.1f\n", astrSets[iSet], dG, dLoop, dBuilder);
+  }
+
+  return 0;
+};
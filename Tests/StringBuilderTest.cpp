@@ -0,0 +1,119 @@
+/* Copyright (c) 2026 Dreamy Cecil
+This program is free software; you can redistribute it and/or modify
+it under the terms of version 2 of the GNU General Public License as published by
+the Free Software Foundation
+
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License along
+with this program; if not, write to the Free Software Foundation, Inc.,
+51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA. */
+
+// Checks of CStringBuilder
+// g++ -O1 -I Tests/Stubs Tests/StringBuilderTest.cpp -o StringBuilderTest
+
+#include "TestCommon.h"
+
+#include "../Base/StringBuilder.h"
+
+// Format a double into a static buffer
+static const char *Double(DOUBLE d) {
+  static char aBuffer[CStringBuilder::NUMBER_SIZE];
+  CStringBuilder::FormatDouble(aBuffer, d);
+  return aBuffer;
+};
+
+// Format a float into a static buffer
+static const char *Float(FLOAT f) {
+  static char aBuffer[CStringBuilder::NUMBER_SIZE];
+  CStringBuilder::FormatFloat(aBuffer, f);
+  return aBuffer;
+};
+
+// Pseudo-random 64 bits
+static UQUAD RandomBits(void) {
+  static UQUAD ullState = 0x123456789ABCDEFULL;
+  ullState ^= ullState << 13;
+  ullState ^= ullState >> 7;
+  ullState ^= ullState << 17;
+  return ullState;
+};
+
+static void TestAppend(void) {
+  CStringBuilder sb;
+  sb.Add("x = ").AddInt(-42).Add(", ").AddHex(255, 4).Add(';');
+  TEST_CHECK(strcmp(sb.c_str(), "x = -42, 00FF;") == 0);
+
+  // Text longer than the inline buffer is moved to the heap
+  for (INDEX i = 0; i < 100; i++) sb.Add("0123456789");
+  TEST_CHECK(sb.Length() == 1014);
+
+  sb.Clear();
+  TEST_CHECK(sb.IsEmpty() && sb.c_str()[0] == '\0');
+};
+
+static void TestDoubles(void) {
+  TEST_CHECK(strcmp(Double(0.1), "0.1") == 0);
+  TEST_CHECK(strcmp(Double(-2.5), "-2.5") == 0);
+  TEST_CHECK(strcmp(Double(1.0 / 3.0), "0.3333333333333333") == 0);
+  TEST_CHECK(strcmp(Double(0.1 + 0.2), "0.30000000000000004") == 0);
+  TEST_CHECK(strcmp(Double(1.1e-10), "1.1e-10") == 0);
+  TEST_CHECK(strcmp(Double(1e300), "1e+300") == 0);
+  TEST_CHECK(strcmp(Double(0.0), "0") == 0);
+  TEST_CHECK(strcmp(Double(-0.0), "-0") == 0);
+
+  // Whole numbers are written without an exponent like "%.15g" would
+  TEST_CHECK(strcmp(Double(123456789012345.0), "123456789012345") == 0);
+  TEST_CHECK(strcmp(Double(1234567.0), "1234567") == 0);
+  TEST_CHECK(strcmp(Double(1e15), "1e+15") == 0);
+
+  // Any double is read back the same way and isn't longer than the shortest "%.Ng" that is
+  for (INDEX i = 0; i < 100000; i++) {
+    const UQUAD ullBits = RandomBits();
+    DOUBLE d;
+    memcpy(&d, &ullBits, sizeof(d));
+
+    // Or numbers with fewer digits
+    if (i & 1) d = DOUBLE(ullBits % 1000000) / (DOUBLE)(1 + ullBits % 10000);
+    if (d != d) continue;
+
+    const char *str = Double(d);
+    TEST_CHECK(strtod(str, NULL) == d);
+
+    char aShortest[32];
+
+    for (int iDigits = 15; iDigits <= 17; iDigits++) {
+      sprintf(aShortest, "%.*g", iDigits, d);
+      if (strtod(aShortest, NULL) == d) break;
+    }
+
+    TEST_CHECK(strlen(str) <= strlen(aShortest));
+  }
+};
+
+static void TestFloats(void) {
+  TEST_CHECK(strcmp(Float(0.1f), "0.1") == 0);
+  TEST_CHECK(strcmp(Float(16777216.0f), "16777216") == 0);
+  TEST_CHECK(strcmp(Float(3.4028235e38f), "3.4028235e+38") == 0);
+
+  for (INDEX i = 0; i < 100000; i++) {
+    const ULONG ulBits = ULONG(RandomBits());
+    FLOAT f;
+    memcpy(&f, &ulBits, sizeof(f));
+    if (f != f) continue;
+
+    TEST_CHECK(FLOAT(strtod(Float(f), NULL)) == f);
+  }
+};
+
+int main() {
+  TestAppend();
+  TestDoubles();
+  TestFloats();
+
+  return TestResult("StringBuilderTest");
+};
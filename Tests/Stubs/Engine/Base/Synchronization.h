@@ -0,0 +1,92 @@
+/* Copyright (c) 2026 Dreamy Cecil
+This program is free software; you can redistribute it and/or modify
+it under the terms of version 2 of the GNU General Public License as published by
+the Free Software Foundation
+
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License along
+with this program; if not, write to the Free Software Foundation, Inc.,
+51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA. */
+
+#ifndef XGIZMO_INCL_STUB_SYNCHRONIZATION_H
+#define XGIZMO_INCL_STUB_SYNCHRONIZATION_H
+
+#ifdef PRAGMA_ONCE
+  #pragma once
+#endif
+
+// Stand-ins for engine synchronization and Win32 interlocked functions
+#ifdef _WIN32
+  #include <windows.h>
+
+  struct CTCriticalSection {
+    CRITICAL_SECTION cs;
+    CTCriticalSection() { InitializeCriticalSection(&cs); };
+    ~CTCriticalSection() { DeleteCriticalSection(&cs); };
+  };
+
+  struct CTSingleLock {
+    CTCriticalSection *sl_pcs;
+    CTSingleLock(CTCriticalSection *pcs, BOOL) : sl_pcs(pcs) { EnterCriticalSection(&sl_pcs->cs); };
+    ~CTSingleLock() { LeaveCriticalSection(&sl_pcs->cs); };
+  };
+
+#else
+  #include <pthread.h>
+
+  typedef long LONG;
+  typedef void *PVOID;
+
+  struct CTCriticalSection {
+    pthread_mutex_t cs;
+
+    CTCriticalSection() {
+      pthread_mutexattr_t attr;
+      pthread_mutexattr_init(&attr);
+      pthread_mutexattr_settype(&attr, PTHREAD_MUTEX_RECURSIVE);
+      pthread_mutex_init(&cs, &attr);
+      pthread_mutexattr_destroy(&attr);
+    };
+
+    ~CTCriticalSection() { pthread_mutex_destroy(&cs); };
+  };
+
+  struct CTSingleLock {
+    CTCriticalSection *sl_pcs;
+    CTSingleLock(CTCriticalSection *pcs, BOOL) : sl_pcs(pcs) { pthread_mutex_lock(&sl_pcs->cs); };
+    ~CTSingleLock() { pthread_mutex_unlock(&sl_pcs->cs); };
+  };
+
+  inline PVOID InterlockedExchangePointer(PVOID volatile *pTarget, PVOID pValue) {
+    return __atomic_exchange_n(pTarget, pValue, __ATOMIC_SEQ_CST);
+  };
+
+  inline PVOID InterlockedCompareExchangePointer(PVOID volatile *pTarget, PVOID pExchange, PVOID pComparand) {
+    __atomic_compare_exchange_n(pTarget, &pComparand, pExchange, false, __ATOMIC_SEQ_CST, __ATOMIC_SEQ_CST);
+    return pComparand;
+  };
+
+  inline LONG InterlockedIncrement(volatile LONG *pTarget) {
+    return __atomic_add_fetch(pTarget, 1, __ATOMIC_SEQ_CST);
+  };
+
+  inline LONG InterlockedDecrement(volatile LONG *pTarget) {
+    return __atomic_sub_fetch(pTarget, 1, __ATOMIC_SEQ_CST);
+  };
+
+  inline LONG InterlockedCompareExchange(volatile LONG *pTarget, LONG lExchange, LONG lComparand) {
+    __atomic_compare_exchange_n(pTarget, &lComparand, lExchange, false, __ATOMIC_SEQ_CST, __ATOMIC_SEQ_CST);
+    return lComparand;
+  };
+
+  inline LONG InterlockedExchange(volatile LONG *pTarget, LONG lValue) {
+    return __atomic_exchange_n(pTarget, lValue, __ATOMIC_SEQ_CST);
+  };
+#endif
+
+#endif
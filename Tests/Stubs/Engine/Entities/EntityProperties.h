@@ -0,0 +1,198 @@
+/* Copyright (c) 2026 Dreamy Cecil
+This program is free software; you can redistribute it and/or modify
+it under the terms of version 2 of the GNU General Public License as published by
+the Free Software Foundation
+
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License along
+with this program; if not, write to the Free Software Foundation, Inc.,
+51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA. */
+
+// Stand-in for entity property types and the math types that they use
+// Only has what's needed by the library code; rotation functions don't do the real math
+
+#ifndef XGIZMO_INCL_STUB_ENTITYPROPERTIES_H
+#define XGIZMO_INCL_STUB_ENTITYPROPERTIES_H
+
+#include "../../EngineStub.h"
+
+class CEntityProperty {
+  public:
+    enum PropertyType {
+      EPT_ENUM = 1,
+      EPT_BOOL = 2,
+      EPT_FLOAT = 3,
+      EPT_COLOR = 4,
+      EPT_STRING = 5,
+      EPT_RANGE = 6,
+      EPT_ENTITYPTR = 7,
+      EPT_FILENAME = 8,
+      EPT_INDEX = 9,
+      EPT_ANIMATION = 10,
+      EPT_ILLUMINATIONTYPE = 11,
+      EPT_FLOATAABBOX3D = 12,
+      EPT_ANGLE = 13,
+      EPT_FLOAT3D = 14,
+      EPT_ANGLE3D = 15,
+      EPT_FLOATplane3D = 16,
+      EPT_MODELOBJECT = 17,
+      EPT_PLACEMENT3D = 18,
+      EPT_ANIMOBJECT = 19,
+      EPT_FILENAMENODEP = 20,
+      EPT_SOUNDOBJECT = 21,
+      EPT_STRINGTRANS = 22,
+      EPT_FLOATQUAT3D = 23,
+      EPT_FLOATMATRIX3D = 24,
+    };
+};
+
+template<class Type, int iDimensions>
+class Vector {
+  public:
+    Type vector[iDimensions];
+
+    Vector() {};
+
+    Vector(Type x, Type y, Type z) {
+      vector[0] = x;
+      vector[1] = y;
+      vector[2] = z;
+    };
+
+    Type &operator()(int i) { return vector[i - 1]; };
+    const Type &operator()(int i) const { return vector[i - 1]; };
+
+    bool operator==(const Vector &other) const {
+      for (int i = 0; i < iDimensions; i++) {
+        if (vector[i] != other.vector[i]) return false;
+      }
+      return true;
+    };
+
+    bool operator!=(const Vector &other) const { return !(*this == other); };
+};
+
+typedef Vector<FLOAT, 3> FLOAT3D;
+typedef FLOAT3D ANGLE3D;
+
+template<class Type, int iDimensions>
+class Plane : public Vector<Type, iDimensions> {
+  public:
+    Type pl_distance;
+
+    Plane() {};
+    Plane(const Vector<Type, iDimensions> &v, Type fDistance) : Vector<Type, iDimensions>(v), pl_distance(fDistance) {};
+};
+
+typedef Plane<FLOAT, 3> FLOATplane3D;
+
+class CPlacement3D {
+  public:
+    FLOAT3D pl_PositionVector;
+    ANGLE3D pl_OrientationAngle;
+
+    CPlacement3D() {};
+    CPlacement3D(const FLOAT3D &vPos, const ANGLE3D &aRot) : pl_PositionVector(vPos), pl_OrientationAngle(aRot) {};
+};
+
+template<class Type, int iDimensions>
+class AABBox {
+  public:
+    Vector<Type, iDimensions> minvect, maxvect;
+
+    AABBox() {};
+
+    // Box around a point
+    AABBox(const Vector<Type, iDimensions> &vCenter, Type fRadius) {
+      for (int i = 1; i <= iDimensions; i++) {
+        minvect(i) = vCenter(i) - fRadius;
+        maxvect(i) = vCenter(i) + fRadius;
+      }
+    };
+
+    // Box between two points
+    AABBox(const Vector<Type, iDimensions> &vPoint1, const Vector<Type, iDimensions> &vPoint2) {
+      for (int i = 1; i <= iDimensions; i++) {
+        minvect(i) = (vPoint1(i) < vPoint2(i)) ? vPoint1(i) : vPoint2(i);
+        maxvect(i) = (vPoint1(i) < vPoint2(i)) ? vPoint2(i) : vPoint1(i);
+      }
+    };
+
+    const Vector<Type, iDimensions> &Min(void) const { return minvect; };
+    const Vector<Type, iDimensions> &Max(void) const { return maxvect; };
+};
+
+typedef AABBox<FLOAT, 3> FLOATaabbox3D;
+
+template<class Type, int iRows, int iColumns>
+class Matrix {
+  public:
+    Type matrix[iRows][iColumns];
+
+    Matrix() {};
+
+    // Diagonal matrix
+    Matrix(Type x) {
+      for (int r = 0; r < iRows; r++) {
+        for (int c = 0; c < iColumns; c++) {
+          matrix[r][c] = (r == c) ? x : 0;
+        }
+      }
+    };
+
+    Type &operator()(int r, int c) { return matrix[r - 1][c - 1]; };
+    const Type &operator()(int r, int c) const { return matrix[r - 1][c - 1]; };
+};
+
+typedef Matrix<FLOAT, 3, 3> FLOATmatrix3D;
+
+template<class Type>
+class Quaternion {
+  public:
+    Type q_w, q_x, q_y, q_z;
+
+    Quaternion() {};
+    Quaternion(Type w, Type x, Type y, Type z) : q_w(w), q_x(x), q_y(y), q_z(z) {};
+
+    // Reversible stand-ins for conversions between quaternions and matrices
+    void FromMatrix(const Matrix<Type, 3, 3> &m) {
+      q_w = m(1, 1);
+      q_x = m(1, 2);
+      q_y = m(2, 3);
+      q_z = m(3, 1);
+    };
+
+    void ToMatrix(Matrix<Type, 3, 3> &m) const {
+      m = Matrix<Type, 3, 3>(q_w);
+      m(1, 2) = q_x;
+      m(2, 3) = q_y;
+      m(3, 1) = q_z;
+    };
+};
+
+typedef Quaternion<FLOAT> FLOATquat3D;
+
+// Reversible stand-ins for conversions between angles and rotation matrices
+inline void MakeRotationMatrix(FLOATmatrix3D &m, const ANGLE3D &a) {
+  m = FLOATmatrix3D(1.0f);
+  m(1, 2) = a(1);
+  m(2, 3) = a(2);
+  m(3, 1) = a(3);
+};
+
+inline void MakeRotationMatrixFast(FLOATmatrix3D &m, const ANGLE3D &a) {
+  MakeRotationMatrix(m, a);
+};
+
+inline void DecomposeRotationMatrixNoSnap(ANGLE3D &a, const FLOATmatrix3D &m) {
+  a(1) = m(1, 2);
+  a(2) = m(2, 3);
+  a(3) = m(3, 1);
+};
+
+#endif
@@ -0,0 +1,249 @@
+/* Copyright (c) 2026 Dreamy Cecil
+This program is free software; you can redistribute it and/or modify
+it under the terms of version 2 of the GNU General Public License as published by
+the Free Software Foundation
+
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License along
+with this program; if not, write to the Free Software Foundation, Inc.,
+51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA. */
+
+#ifndef XGIZMO_INCL_ENGINESTUB_H
+#define XGIZMO_INCL_ENGINESTUB_H
+
+#ifdef PRAGMA_ONCE
+  #pragma once
+#endif
+
+// Minimal stand-ins for engine types that let headers be tested and benchmarked outside of the engine
+// Only the parts that XGizmo headers actually use are implemented and they behave the same way as in the engine.
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdarg.h>
+#include <errno.h>
+#include <assert.h>
+#include <string>
+
+#ifdef _MSC_VER
+  #define strcasecmp _stricmp
+#else
+  #include <strings.h>
+  #define __forceinline inline __attribute__((always_inline))
+  #define stricmp strcasecmp
+#endif
+
+// Engine types
+typedef int SLONG;
+typedef unsigned int ULONG;
+typedef short SWORD;
+typedef unsigned short UWORD;
+typedef unsigned char UBYTE;
+typedef int BOOL;
+typedef long INDEX;
+typedef float FLOAT;
+typedef double DOUBLE;
+
+#ifndef _MSC_VER
+  #define __int64 long long
+#endif
+
+typedef __int64 SQUAD;
+typedef unsigned __int64 UQUAD;
+
+#define TRUE  1
+#define FALSE 0
+
+#define ASSERT(_Expr) assert(_Expr)
+#define ASSERTALWAYS(_Message) assert(!_Message)
+
+#define TRANSV(_String) (_String)
+
+// Debug allocations are just regular ones
+#define DEBUG_NEW_CT new
+
+// Limit a value from above
+template<class Type> inline Type ClampUp(const Type x, const Type tUp) {
+  return (x <= tUp) ? x : tUp;
+};
+
+// Case-insensitive engine string
+class CTString {
+  public:
+    char *str_String;
+
+  public:
+    CTString() : str_String(Dup("")) {};
+    CTString(const char *str) : str_String(Dup(str)) {};
+    CTString(const CTString &str) : str_String(Dup(str.str_String)) {};
+
+    // Formatted string
+    CTString(int, const char *strFormat, ...) {
+      char strBuffer[1024];
+      va_list arg;
+      va_start(arg, strFormat);
+      vsnprintf(strBuffer, sizeof(strBuffer), strFormat, arg);
+      va_end(arg);
+
+      str_String = Dup(strBuffer);
+    };
+
+    ~CTString() {
+      free(str_String);
+    };
+
+    static char *Dup(const char *str) {
+      const size_t ct = strlen(str) + 1;
+      return (char *)memcpy(malloc(ct), str, ct);
+    };
+
+    CTString &operator=(const char *str) {
+      char *strNew = Dup(str);
+      free(str_String);
+      str_String = strNew;
+      return *this;
+    };
+
+    CTString &operator=(const CTString &str) {
+      return (*this = str.str_String);
+    };
+
+    operator const char *() const { return str_String; };
+    INDEX Length(void) const { return (INDEX)strlen(str_String); };
+
+    bool operator==(const char *str) const { return strcasecmp(str_String, str) == 0; };
+    bool operator!=(const char *str) const { return !(*this == str); };
+
+    CTString operator+(const CTString &str) const {
+      std::string strSum = std::string(str_String) + str.str_String;
+      return CTString(strSum.c_str());
+    };
+
+    CTString &operator+=(const CTString &str) {
+      return (*this = *this + str);
+    };
+
+    void PrintF(const char *strFormat, ...) {
+      char strBuffer[1024];
+      va_list arg;
+      va_start(arg, strFormat);
+      vsnprintf(strBuffer, sizeof(strBuffer), strFormat, arg);
+      va_end(arg);
+
+      *this = strBuffer;
+    };
+};
+
+inline CTString operator+(const char *str1, const CTString &str2) {
+  return CTString(str1) + str2;
+};
+
+// Engine file name
+class CTFileName : public CTString {
+  public:
+    CTFileName() {};
+    CTFileName(const char *str) : CTString(str) {};
+    CTFileName(const CTString &str) : CTString(str) {};
+};
+
+#define SE_INCL_CTSTRING_H
+#define SE_INCL_FILENAME_H
+
+// Errors are thrown as formatted strings
+inline void ThrowF_t(char *strFormat, ...) {
+  char strBuffer[1024];
+  va_list arg;
+  va_start(arg, strFormat);
+  vsnprintf(strBuffer, sizeof(strBuffer), strFormat, arg);
+  va_end(arg);
+
+  throw CTString::Dup(strBuffer);
+};
+
+// Engine stream over a standard file
+class CTStream {
+  public:
+    FILE *strm_pFile;
+    CTString strm_strStreamDescription;
+
+  public:
+    CTStream() : strm_pFile(NULL) {};
+
+    void Read_t(void *pData, SLONG slSize) {
+      if ((SLONG)fread(pData, 1, slSize, strm_pFile) != slSize) ThrowF_t((char *)"Cannot read from stream");
+    };
+
+    void Write_t(const void *pData, SLONG slSize) {
+      fwrite(pData, 1, slSize, strm_pFile);
+    };
+
+    // Line breaks are written as CRLF, like the engine does
+    void PutString_t(const char *str) {
+      for (; *str != '\0'; str++) {
+        if (*str == '\n') Write_t("\r", 1);
+        Write_t(str, 1);
+      }
+    };
+
+    SLONG GetPos_t(void) { return ftell(strm_pFile); };
+    void SetPos_t(SLONG slPos) { fseek(strm_pFile, slPos, SEEK_SET); };
+
+    SLONG GetStreamSize(void) {
+      const long lPos = ftell(strm_pFile);
+      fseek(strm_pFile, 0, SEEK_END);
+
+      const long lSize = ftell(strm_pFile);
+      fseek(strm_pFile, lPos, SEEK_SET);
+      return lSize;
+    };
+
+    BOOL AtEOF(void) {
+      const int iChar = fgetc(strm_pFile);
+      if (iChar == EOF) return TRUE;
+
+      ungetc(iChar, strm_pFile);
+      return FALSE;
+    };
+
+    BOOL IsReadable(void) { return TRUE; };
+
+    template<class Type> CTStream &operator>>(Type &val) { Read_t(&val, sizeof(val)); return *this; };
+    template<class Type> CTStream &operator<<(const Type &val) { Write_t(&val, sizeof(val)); return *this; };
+};
+
+class CTFileStream : public CTStream {
+  public:
+    ~CTFileStream() {
+      Close();
+    };
+
+    void Open_t(const CTString &strFile) {
+      strm_pFile = fopen(strFile.str_String, "rb");
+      if (strm_pFile == NULL) ThrowF_t((char *)"Cannot open file '%s'", strFile.str_String);
+    };
+
+    void Create_t(const CTString &strFile) {
+      strm_pFile = fopen(strFile.str_String, "wb");
+      if (strm_pFile == NULL) ThrowF_t((char *)"Cannot create file '%s'", strFile.str_String);
+    };
+
+    void Close(void) {
+      if (strm_pFile != NULL) fclose(strm_pFile);
+      strm_pFile = NULL;
+    };
+};
+
+// Game directory is the current directory
+#define XGIZMO_INCL_DIRECTORIESINTERFACE_H
+
+namespace IDir {
+  inline CTFileName AppPath(void) { return CTFileName(""); };
+};
+
+#endif
@@ -0,0 +1,69 @@
+/* Copyright (c) 2026 Dreamy Cecil
+This program is free software; you can redistribute it and/or modify
+it under the terms of version 2 of the GNU General Public License as published by
+the Free Software Foundation
+
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License along
+with this program; if not, write to the Free Software Foundation, Inc.,
+51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA. */
+
+#ifndef XGIZMO_INCL_TESTCOMMON_H
+#define XGIZMO_INCL_TESTCOMMON_H
+
+#ifdef PRAGMA_ONCE
+  #pragma once
+#endif
+
+#include "Stubs/EngineStub.h"
+
+#include <time.h>
+
+#ifdef _WIN32
+  #include <windows.h>
+#endif
+
+// Amount of failed checks
+static int _ctTestFailures = 0;
+
+// Check some condition and report it if it fails
+#define TEST_CHECK(_Expr) \
+  if (!(_Expr)) { \
+    fprintf(stderr, "%s(%d): check failed: %s\n", __FILE__, __LINE__, #_Expr); \
+    _ctTestFailures++; \
+  }
+
+// Report the result of all checks and return it from main()
+inline int TestResult(const char *strTest) {
+  if (_ctTestFailures == 0) {
+    printf("%s: OK\n", strTest);
+    return 0;
+  }
+
+  printf("%s: %d check(s) failed\n", strTest, _ctTestFailures);
+  return 1;
+};
+
+// Current time in seconds for benchmarks
+inline double TestSeconds(void) {
+#ifdef _WIN32
+  LARGE_INTEGER llFreq, llCounter;
+  QueryPerformanceFrequency(&llFreq);
+  QueryPerformanceCounter(&llCounter);
+  return (double)llCounter.QuadPart / (double)llFreq.QuadPart;
+#else
+  timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return (double)ts.tv_sec + (double)ts.tv_nsec * 1e-9;
+#endif
+};
+
+// Sink for benchmark results that must not be optimized away
+static volatile size_t _iTestSink = 0;
+
+#endif